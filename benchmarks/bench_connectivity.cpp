@@ -0,0 +1,52 @@
+// Network setup benchmark: native connectivity generators vs. an add_synapse loop
+// (the pattern used by the Python notebooks). Usage: bench_connectivity [n_neurons] [p] [threads]
+#include "NeuralNetwork.h"
+#include "LIFNeuron.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+
+using Clock = std::chrono::steady_clock;
+
+static double seconds_since(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000;
+    double p = argc > 2 ? std::atof(argv[2]) : 0.01;
+    size_t threads = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 1;
+
+    // Baseline: one add_synapse call per connection, Bernoulli draw per pair
+    {
+        NeuralNetwork net;
+        net.add_neuron_population(n, std::make_shared<LIFNeuron>());
+        auto start = Clock::now();
+        std::mt19937_64 gen(1);
+        std::bernoulli_distribution connect(p);
+        std::uniform_real_distribution<double> weight(0.1, 0.2);
+        size_t count = 0;
+        for (size_t i = 0; i < n; ++i)
+            for (size_t j = 0; j < n; ++j)
+                if (i != j && connect(gen)) {
+                    net.add_synapse(Synapse(i, j, weight(gen), 0.001));
+                    ++count;
+                }
+        net.get_synapses();
+        std::printf("add_synapse loop:  %zu synapses in %.3f s\n", count, seconds_since(start));
+    }
+
+    // Native generator
+    {
+        NeuralNetwork net;
+        net.add_neuron_population(n, std::make_shared<LIFNeuron>());
+        net.set_num_exec_threads(threads);
+        auto start = Clock::now();
+        size_t count = net.connect_random(0, 0, p, Distribution::uniform(0.1, 0.2), Distribution(0.001), 1, false);
+        net.get_synapses();
+        std::printf("connect_random:    %zu synapses in %.3f s (%zu threads)\n", count, seconds_since(start), threads);
+    }
+    return 0;
+}
@@ -0,0 +1,48 @@
+// Fan-out benchmark: double build (NeuralNetwork) vs. float build (NeuralNetworkF32) of the same network.
+// Only the synapse storage changes (float weights, 32-bit targets and row index); neuron state stays double.
+// Reports the bytes read per delivered synapse and delivered synaptic events per second.
+// Usage: bench_precision [n_neurons] [p] [T]
+#include "NeuralNetwork.h"
+#include "LIFNeuron.h"
+#include "InputNeuron.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+
+using Clock = std::chrono::steady_clock;
+
+static double seconds_since(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+template <class Weight>
+static void bench(const char* label, size_t n, double p, double T) {
+    BasicNeuralNetwork<Weight> net;
+    net.add_neuron_population(n, std::make_shared<InputNeuron>());
+    net.add_neuron_population(n, std::make_shared<LIFNeuron>(0.02, 1.0, 0.0, 0.0, 1.0, 0.002));
+    size_t n_synapses = net.connect_random(0, 1, p, Distribution::uniform(0.0, 0.05), Distribution(0.001), 1);
+
+    // Every input neuron fires at 50 Hz
+    size_t n_input_spikes = 0;
+    for (size_t i = 0; i < n; ++i)
+        for (double t = 0.02 * i / n; t < T; t += 0.02, ++n_input_spikes)
+            net.schedule_spike_event(t, i, 1.0);
+
+    auto start = Clock::now();
+    net.run(T);
+    double elapsed = seconds_since(start);
+    double events = static_cast<double>(n_input_spikes) * n_synapses / n;
+    std::printf("%-8s %2zu bytes/delivered synapse  %8.2f M synaptic events/s\n", label,
+                sizeof(SynapseIndex<Weight>) + sizeof(Weight), events / elapsed * 1e-6);
+}
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000;
+    double p = argc > 2 ? std::atof(argv[2]) : 0.02;
+    double T = argc > 3 ? std::atof(argv[3]) : 0.2;
+
+    bench<double>("double", n, p, T);
+    bench<float>("float", n, p, T);
+    return 0;
+}
@@ -0,0 +1,49 @@
+// Per-call overhead of chunked simulation: run(dt) vs. step() on an idle network.
+// The neurons have a subthreshold bias current, so they predict (but never reach) threshold crossings
+// and no events are processed - the timings are the fixed cost of a call. Nothing changes between calls,
+// so neither path refreshes the predictions and both should stay flat with the network size.
+// Usage: bench_step_overhead [n_calls] [dt]
+#include "NeuralNetwork.h"
+#include "LIFNeuron.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+
+using Clock = std::chrono::steady_clock;
+
+static double seconds_since(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+static void bench(size_t n, size_t n_calls, double dt) {
+    auto build = [&](NeuralNetwork& net) {
+        // Steady state 0.8 with a threshold of 1
+        net.add_neuron_population(n, std::make_shared<LIFNeuron>(0.02, 1.0, 0.0, 0.0, 1.0, 0.002, 40.0));
+        net.set_spike_count_monitor(std::make_shared<SpikeCountMonitor>());
+        net.run(0.0);
+    };
+
+    NeuralNetwork run_net;
+    build(run_net);
+    auto start = Clock::now();
+    for (size_t k = 0; k < n_calls; ++k) run_net.run(dt);
+    double run_us = seconds_since(start) / n_calls * 1e6;
+
+    NeuralNetwork step_net;
+    build(step_net);
+    step_net.set_step(dt);
+    start = Clock::now();
+    for (size_t k = 0; k < n_calls; ++k) step_net.step();
+    double step_us = seconds_since(start) / n_calls * 1e6;
+
+    std::printf("%8zu neurons  run(dt) %9.3f us/call  step() %7.3f us/call\n", n, run_us, step_us);
+}
+
+int main(int argc, char** argv) {
+    size_t n_calls = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000;
+    double dt = argc > 2 ? std::atof(argv[2]) : 1e-3;
+
+    for (size_t n : {100, 10000, 1000000}) bench(n, n_calls, dt);
+    return 0;
+}
@@ -0,0 +1,58 @@
+// Fan-out benchmark: CSR synapse storage vs. CompressedProjection (int8 / int16 weights).
+// Reports memory per synapse and delivered synaptic events per second.
+// Usage: bench_synapse_compression [n_neurons] [p] [T]
+#include "NeuralNetwork.h"
+#include "LIFNeuron.h"
+#include "InputNeuron.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+
+using Clock = std::chrono::steady_clock;
+using WeightBits = CompressedProjection::WeightBits;
+
+static double seconds_since(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// Input population driving a LIF reservoir through random connectivity - only the storage changes
+static void bench(const char* label, size_t n, double p, double T, bool compress, WeightBits bits) {
+    NeuralNetwork net;
+    net.add_neuron_population(n, std::make_shared<InputNeuron>());
+    net.add_neuron_population(n, std::make_shared<LIFNeuron>(0.02, 1.0, 0.0, 0.0, 1.0, 0.002));
+    size_t n_synapses = net.connect_random(0, 1, p, Distribution::uniform(0.0, 0.05), Distribution(0.001), 1);
+
+    double bytes;
+    if (compress) {
+        auto proj = net.compress_synapses(0, 1, bits);
+        bytes = static_cast<double>(proj->memory_bytes());
+    } else {
+        net.num_synapses();
+        // Targets, weights, delays and the row index
+        bytes = static_cast<double>(n_synapses * (sizeof(size_t) + 2 * sizeof(double)) + (n + 1) * sizeof(size_t));
+    }
+
+    // Every input neuron fires at 50 Hz
+    size_t n_input_spikes = 0;
+    for (size_t i = 0; i < n; ++i)
+        for (double t = 0.02 * i / n; t < T; t += 0.02, ++n_input_spikes)
+            net.schedule_spike_event(t, i, 1.0);
+
+    auto start = Clock::now();
+    net.run(T);
+    double elapsed = seconds_since(start);
+    double events = static_cast<double>(n_input_spikes) * n_synapses / n;
+    std::printf("%-12s %6.2f bytes/synapse  %8.2f M synaptic events/s\n", label, bytes / n_synapses, events / elapsed * 1e-6);
+}
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000;
+    double p = argc > 2 ? std::atof(argv[2]) : 0.02;
+    double T = argc > 3 ? std::atof(argv[3]) : 0.2;
+
+    bench("CSR", n, p, T, false, WeightBits::Int8);
+    bench("int16", n, p, T, true, WeightBits::Int16);
+    bench("int8", n, p, T, true, WeightBits::Int8);
+    return 0;
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include "MultiStateNeuron.h"
+
+// Adaptive exponential integrate-and-fire neuron (Brette & Gerstner, 2005)
+// State variables: 0 - membrane potential v, 1 - adaptation current w
+//   C_m dv/dt = -g_L (v - E_L) + g_L delta_T exp((v - v_T) / delta_T) - w
+//   tau_w dw/dt = a (v - E_L) - w
+// Incoming charge q changes v by q / C_m. On a spike v = v_reset and w += b.
+// Between events the equations are integrated with forward Euler steps of at most dt_int. Crossings of v_peak
+// without input (e.g. the runaway past v_T) are predicted by integrating ahead PREDICTION_STEPS steps at a time
+// until the neuron crosses or settles, and fire at the end of the crossing step.
+class AdExNeuron : public MultiStateNeuron {
+public:
+    AdExNeuron(double C_m = 281e-12, // [F]
+               double g_L = 30e-9, // [S]
+               double E_L = -70.6e-3, // [V]
+               double v_T = -50.4e-3, // [V]
+               double delta_T = 2e-3, // [V]
+               double a = 4e-9, // [S]
+               double tau_w = 0.144, // [s]
+               double b = 0.0805e-9, // [A]
+               double v_reset = -70.6e-3, // [V]
+               double v_peak = 0.0, // [V]
+               double dt_int = 1e-4 // [s]
+    );
+
+    size_t get_num_state_vars() override;
+    double get_init_state(size_t var) override;
+    void decay_vars(double t, double* const* vars, double* last_spike, double* last_update, size_t n) override;
+    bool receive_vars(double t, double charge, double* const* vars, double* last_spike, double* last_update) override;
+
+    bool predicts_spikes(double* const* vars, size_t n) override;
+    double next_spike_time(double* const* vars, double* last_spike, double* last_update) override;
+    bool fire_vars(double t, double* const* vars, double* last_spike, double* last_update) override;
+
+    // Steps integrated ahead per prediction - a neuron still moving after them is predicted again
+    static constexpr size_t PREDICTION_STEPS = 64;
+
+    // Public variable to make acess easier from Python
+    double C_m_;
+    double g_L_;
+    double E_L_;
+    double v_T_;
+    double delta_T_;
+    double a_;
+    double tau_w_;
+    double b_;
+    double v_reset_;
+    double v_peak_;
+    double dt_int_;
+
+private:
+    // One forward Euler step of length h
+    void step(double& v, double& w, double h) const;
+};
@@ -0,0 +1,92 @@
+#pragma once
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "Connectivity.h"
+#include "NeuralNetwork.h"
+#include "Synapse.h"
+
+// Native batch inference: a network description and per-sample input spikes, run without Python.
+//
+// Network description - one statement per line, '#' starts a comment:
+//   population <size> <model> [constructor arguments...]   models: lif, exp_lif, adex, izhikevich, input
+//   synapse <src> <dst> <weight> <delay>
+//   connect_random <pre_pop> <post_pop> <p> <weight> <delay> [seed] [allow_autapses]
+//   connect_fixed_outdegree <pre_pop> <post_pop> <k> <weight> <delay> [seed] [allow_autapses]
+//   connect_fixed_indegree <pre_pop> <post_pop> <k> <weight> <delay> [seed] [allow_autapses]
+// Missing constructor arguments take the model defaults. Weights and delays of connect_* are a number,
+// uniform:<low>:<high> or normal:<mean>:<std>.
+//
+// Input spikes - one per line: <sample> <time> <neuron> [weight = 1], times relative to the sample start.
+struct NetworkSpec {
+    struct Population {
+        size_t size;
+        std::string model;
+        std::vector<double> args;
+    };
+    struct Connection {
+        std::string rule;   // connect_random, connect_fixed_outdegree or connect_fixed_indegree
+        size_t pre_pop;
+        size_t post_pop;
+        double p_or_k;
+        Distribution weight;
+        Distribution delay;
+        uint64_t seed;
+        bool allow_autapses;
+    };
+
+    std::vector<Population> populations;
+    std::vector<Synapse> synapses;
+    std::vector<Connection> connections;
+};
+
+struct InputSample {
+    std::vector<double> times;
+    std::vector<size_t> neurons;
+    std::vector<double> weights;
+};
+
+struct SampleResult {
+    std::vector<uint64_t> counts;                  // Spikes per neuron of the readout range
+    std::vector<std::pair<double, size_t>> spikes; // (time, neuron_id) - only recorded if requested
+};
+
+// Parsers throw std::invalid_argument naming the offending line; the file loaders std::runtime_error
+// if the file cannot be opened
+NetworkSpec parse_network_spec(std::istream& in);
+NetworkSpec load_network_spec(const std::string& path);
+std::vector<InputSample> parse_input_samples(std::istream& in);
+std::vector<InputSample> load_input_samples(const std::string& path);
+
+// Model of a population statement
+std::shared_ptr<Neuron> make_neuron_model(const std::string& model, const std::vector<double>& args);
+// Adds the populations, synapses and connections of the spec to an empty network
+void build_network(const NetworkSpec& spec, NeuralNetwork& net);
+
+// Runs every sample for `duration` on a network built from the spec, samples in parallel over n_threads
+// OpenMP threads (0: all available). Each thread builds the network once and resets it before every sample
+// (BasicNeuralNetwork::reset), so the results do not depend on the thread count or on earlier samples.
+class BatchRunner {
+public:
+    BatchRunner(NetworkSpec spec, double duration);
+
+    // Neurons whose spikes are reported (default: all)
+    void set_readout(size_t first_neuron, size_t n_neurons);
+    void set_record_spikes(bool record);
+
+    std::vector<SampleResult> run(const std::vector<InputSample>& samples, size_t n_threads = 0) const;
+
+private:
+    // Network of one thread and its monitors
+    struct Worker;
+    SampleResult run_sample(Worker& worker, const InputSample& sample) const;
+
+    NetworkSpec spec_;
+    double duration_;
+    size_t readout_first_;
+    size_t readout_size_;   // 0: up to the last neuron
+    bool record_spikes_;
+};
@@ -0,0 +1,31 @@
+#pragma once
+#include <cstdint>
+#include "Neuron.h"
+
+// Models evaluated once per batch of input events instead of once per event - meant for models whose
+// per-call overhead dominates (e.g. Python models). The network gathers the inputs of a population over
+// a window, bounded by the minimum delay of the synapses leaving it so no spike can arrive late,
+// and hands them to process_batch in time order. Single-state models only.
+// Populations without outgoing synapses gather until the next state monitor reading or the end of the run.
+// Spikes reach the monitors only when the batch is flushed, so batched populations cannot be covered by
+// an STDP rule, a windowed SpikeCountMonitor or a FeatureMonitor (run throws std::logic_error).
+class BatchedNeuron : public Neuron {
+public:
+    // window <= 0: use the minimum outgoing delay of the population
+    explicit BatchedNeuron(double window = 0.0) : window_(window) {}
+
+    // n events in time order: targets relative to the population, times and charges.
+    // state/last_spike/last_update are the arrays of the whole population (n_neurons entries).
+    // Must bring each target up to its event time, apply the charge, and set fired[i] = 1
+    // (with reset/last_spike handled by the model) if event i made its target spike.
+    virtual void process_batch(size_t n, const size_t* targets, const double* times, const double* charges,
+                               double* state, double* last_spike, double* last_update, size_t n_neurons,
+                               uint8_t* fired) = 0;
+
+    // Batch of one - used when a single event is delivered outside the network
+    bool receive(double t, double charge, double* state, double* last_spike, double* last_update) override;
+
+    size_t get_num_state_vars() final { return 1; }
+
+    double window_;
+};
@@ -0,0 +1,60 @@
+#pragma once
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Neuron.h"
+
+// Neuron model given as equations. compile_model turns it into specialized SoA kernels, compiles them
+// with the system compiler (cached by hash of the generated source) and loads the shared object.
+// Statements and expressions are C++ over the state variables, the parameters and:
+//   dt - time since the last update (decay), charge - input weight (input), t - current time.
+// Between inputs the states follow `decay` (the analytic solution); during the refractory period
+// the states are held and inputs are ignored, as in LIFNeuron.
+struct ModelDefinition {
+    std::vector<std::string> state_vars;    // Variable 0 is the primary state (recorded by StateMonitor)
+    std::vector<double> init_values;        // One per state variable
+    std::map<std::string, double> params;   // Constants inlined in the generated code
+    std::string decay;                      // Statements advancing the states by dt
+    std::string input;                      // Statements applying an input of size charge
+    std::string threshold;                  // Spike condition
+    std::string reset;                      // Statements applied after a spike
+    double refractory = 0.0;
+};
+
+class CompiledNeuron : public Neuron {
+public:
+    using DecayFn = void (*)(double t, double* const* vars, double* last_spike, double* last_update, size_t n);
+    using ReceiveFn = bool (*)(double t, double charge, double* const* vars, double* last_spike, double* last_update);
+
+    CompiledNeuron(ModelDefinition definition, std::shared_ptr<void> library, DecayFn decay_fn, ReceiveFn receive_fn,
+                   std::string library_path);
+
+    // Single-state entry points - only valid for models with one state variable
+    void decay(double t, double* state, double* last_spike, double* last_update, size_t n) override;
+    bool receive(double t, double charge, double* state, double* last_spike, double* last_update) override;
+    double get_init_value() override;
+
+    size_t get_num_state_vars() override;
+    double get_init_state(size_t var) override;
+    void decay_vars(double t, double* const* vars, double* last_spike, double* last_update, size_t n) override;
+    bool receive_vars(double t, double charge, double* const* vars, double* last_spike, double* last_update) override;
+
+    ModelDefinition definition_;
+    std::string library_path_;
+
+private:
+    std::shared_ptr<void> library_;   // dlopen handle, closed with the last user
+    DecayFn decay_fn_;
+    ReceiveFn receive_fn_;
+};
+
+// C++ source of the kernels for a definition (throws std::invalid_argument on malformed names)
+std::string generate_model_source(const ModelDefinition& definition);
+
+// Generates, compiles (or reuses the cached build) and loads a model. cache_dir defaults to $SNNBLAZE_CACHE_DIR,
+// else $XDG_CACHE_HOME/snnblaze_models or ~/.cache/snnblaze_models; the compiler to $SNNBLAZE_CXX, $CXX or c++.
+// Builds target the host CPU and are keyed by its instruction set. The cache directory is created private (0700);
+// a directory or library not owned by the current user, or writable by others, is refused.
+// Throws std::runtime_error with the compiler output if the build fails.
+std::shared_ptr<CompiledNeuron> compile_model(const ModelDefinition& definition, const std::string& cache_dir = "");
@@ -0,0 +1,58 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Projection.h"
+
+// Stored connectivity in a compact encoding, decoded when it is delivered - about 2-3 bytes per synapse
+// instead of the 24 of the CSR storage:
+//  - rows split into delay groups, each with a 1-byte index into a table of at most 256 distinct delays
+//  - targets sorted within a group and delta-encoded as LEB128 varints (1 byte for gaps below 128)
+//  - weights quantized to int8 or int16 with one scale per row, or a fixed scale for the whole projection
+// Every delay group of a spike is queued as a single packet and decoded on arrival.
+// Rows are filled once from staged synapses (one vector per source neuron, as built by the connectivity generators).
+class CompressedProjection : public Projection {
+public:
+    enum class WeightBits { Int8, Int16 };
+
+    // weight_scale > 0 fixes the quantization step of the whole projection (out of range weights saturate);
+    // 0 picks the step of each row from its largest weight
+    CompressedProjection(size_t pre_begin, size_t n_pre, size_t post_begin, size_t n_post,
+                         WeightBits bits = WeightBits::Int8, double weight_scale = 0.0);
+
+    // Encodes the rows of the sources of the projection and clears them - may only be called once
+    void compress(std::vector<std::vector<Synapse>>& rows);
+
+    void generate(size_t neuron_id, std::vector<Synapse>& out) const override;
+    void scale_weights(double factor) override;
+    double min_delay() const override;
+
+    size_t num_groups(size_t neuron_id) const override {
+        size_t row = neuron_id - pre_begin_;
+        return row_group_[row + 1] - row_group_[row];
+    }
+    double group_delay(size_t neuron_id, size_t group) const override {
+        return delay_table_[group_delay_[row_group_[neuron_id - pre_begin_] + group]];
+    }
+    void generate_group(size_t neuron_id, size_t group, std::vector<Synapse>& out) const override;
+
+    size_t num_synapses() const { return group_ptr_.back(); }
+    // Bytes used by the encoded synapses and their index
+    size_t memory_bytes() const;
+
+    WeightBits bits_;
+    double weight_scale_;
+
+private:
+    template <class Q>
+    void decode(size_t row, size_t group, const std::vector<Q>& weights, std::vector<Synapse>& out) const;
+
+    std::vector<uint64_t> row_group_;   // First delay group of every row
+    std::vector<uint64_t> group_ptr_;   // First synapse of every group
+    std::vector<uint64_t> group_byte_;  // First byte of every group in target_bytes_
+    std::vector<uint8_t> group_delay_;  // Delay table index of every group
+    std::vector<uint8_t> target_bytes_; // Varint gaps between consecutive targets (first one from post_begin)
+    std::vector<int8_t> weights8_;
+    std::vector<int16_t> weights16_;
+    std::vector<float> row_scales_;     // Quantization step of every row
+    std::vector<double> delay_table_;
+};
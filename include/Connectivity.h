@@ -0,0 +1,63 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Synapse.h"
+#include "CounterRNG.h"
+
+// Distribution of the weights or delays drawn by the connectivity generators
+struct Distribution {
+    enum class Kind { Constant, Uniform, Normal };
+
+    Distribution(double value = 0.0) : kind(Kind::Constant), a(value), b(0.0) {}
+    Distribution(Kind kind, double a, double b) : kind(kind), a(a), b(b) {}
+
+    static Distribution constant(double value) { return Distribution(value); }
+    static Distribution uniform(double low, double high) { return Distribution(Kind::Uniform, low, high); }
+    static Distribution normal(double mean, double std) { return Distribution(Kind::Normal, mean, std); }
+
+    // Draw number `counter` of the given stream - Normal also consumes the mirrored counter
+    double sample(const CounterRNG& rng, uint64_t stream, uint64_t counter) const;
+
+    Kind kind;
+    double a;   // Constant value, lower bound or mean
+    double b;   // Upper bound or standard deviation
+};
+
+// Generators append synapses to rows indexed by source neuron (the network staging storage).
+// Every source (or target, for fixed in-degree) draws from its own RNG stream, so the result
+// for a given seed does not depend on the number of threads. All return the number of synapses created.
+
+// Each pair connected with probability p
+size_t connect_random(std::vector<std::vector<Synapse>>& rows,
+                      size_t pre_begin, size_t n_pre, size_t post_begin, size_t n_post,
+                      double p, const Distribution& weight, const Distribution& delay,
+                      uint64_t seed, bool allow_autapses);
+
+// Exactly k distinct targets per source
+size_t connect_fixed_outdegree(std::vector<std::vector<Synapse>>& rows,
+                               size_t pre_begin, size_t n_pre, size_t post_begin, size_t n_post,
+                               size_t k, const Distribution& weight, const Distribution& delay,
+                               uint64_t seed, bool allow_autapses);
+
+// Exactly k distinct sources per target
+size_t connect_fixed_indegree(std::vector<std::vector<Synapse>>& rows,
+                              size_t pre_begin, size_t n_pre, size_t post_begin, size_t n_post,
+                              size_t k, const Distribution& weight, const Distribution& delay,
+                              uint64_t seed, bool allow_autapses);
+
+// Distance-dependent connectivity (Maass et al. 2002): p = C * exp(-(d / lambda)^2).
+// Positions are (x, y, z) triplets, one per neuron
+size_t connect_distance(std::vector<std::vector<Synapse>>& rows,
+                        size_t pre_begin, const std::vector<double>& pre_positions,
+                        size_t post_begin, const std::vector<double>& post_positions,
+                        double C, double lambda, const Distribution& weight, const Distribution& delay,
+                        uint64_t seed, bool allow_autapses);
+
+// Watts-Strogatz small world within one population: ring lattice to the k nearest neighbours
+// (k/2 on each side), every edge rewired to a random target with probability beta
+size_t connect_small_world(std::vector<std::vector<Synapse>>& rows,
+                           size_t begin, size_t n, size_t k, double beta,
+                           const Distribution& weight, const Distribution& delay, uint64_t seed);
+
+// Positions of an nx * ny * nz grid, x varying fastest
+std::vector<double> grid_positions(size_t nx, size_t ny, size_t nz, double spacing = 1.0);
@@ -0,0 +1,38 @@
+#pragma once
+#include <vector>
+#include "Projection.h"
+
+// 2D convolution between populations laid out on grids (index = (c * height + y) * width + x).
+// The fan-out of a spike is computed from the shared kernel, so memory scales with the kernel size.
+// weights: (out_channels, in_channels, kernel_h, kernel_w), or (channels, kernel_h, kernel_w) when depthwise -
+// a depthwise projection maps every channel to itself (local receptive fields / topographic mapping).
+class ConvProjection : public Projection {
+public:
+    ConvProjection(size_t pre_begin, size_t in_channels, size_t in_height, size_t in_width,
+                   size_t post_begin, size_t out_channels, size_t kernel_h, size_t kernel_w,
+                   const std::vector<double>& weights, double delay = 0.0,
+                   size_t stride = 1, size_t padding = 0, bool depthwise = false);
+
+    void generate(size_t neuron_id, std::vector<Synapse>& out) const override;
+    void scale_weights(double factor) override;
+    double min_delay() const override { return delay_; }
+
+    size_t out_height() const { return out_height_; }
+    size_t out_width() const { return out_width_; }
+
+    size_t in_channels_;
+    size_t in_height_;
+    size_t in_width_;
+    size_t out_channels_;
+    size_t kernel_h_;
+    size_t kernel_w_;
+    size_t stride_;
+    size_t padding_;
+    bool depthwise_;
+    std::vector<double> weights_;
+    double delay_;
+
+private:
+    size_t out_height_;
+    size_t out_width_;
+};
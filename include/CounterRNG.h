@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <cmath>
+
+// Counter-based random number generator: every draw is a pure function of (seed, stream, counter).
+// No state has to be stored or advanced, so draws can be regenerated lazily and in any order,
+// which keeps results independent of event ordering and of the number of threads.
+class CounterRNG {
+public:
+    explicit CounterRNG(uint64_t seed = 0) : seed_(seed) {}
+
+    // 64 random bits for the given stream (e.g. neuron id) and counter (e.g. draw number)
+    uint64_t bits(uint64_t stream, uint64_t counter) const {
+        uint64_t x = mix(seed_ ^ mix(stream + 0x9E3779B97F4A7C15ULL));
+        return mix(x ^ mix(counter + 0xD1B54A32D192ED03ULL));
+    }
+
+    // Uniform double in the open interval (0, 1)
+    double uniform(uint64_t stream, uint64_t counter) const {
+        return ((bits(stream, counter) >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+    }
+
+    // Exponential variate with the given rate
+    double exponential(uint64_t stream, uint64_t counter, double rate) const {
+        return -std::log(uniform(stream, counter)) / rate;
+    }
+
+    uint64_t seed_;
+
+private:
+    // SplitMix64 finalizer
+    static uint64_t mix(uint64_t x) {
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+        return x ^ (x >> 31);
+    }
+};
@@ -0,0 +1,88 @@
+#pragma once
+#include <memory>
+#include <utility>
+#include <vector>
+#include <cstdint>
+#include <mpi.h>
+#include "NeuralNetwork.h"
+
+// Distributed engine (SNNBLAZE_WITH_MPI): every population is split into contiguous blocks, one per rank.
+// Each rank keeps a local NeuralNetwork with its own neurons, queue and outgoing synapses. Spikes bound
+// for other ranks are exchanged with MPI_Alltoallv once per epoch of the minimum inter-rank delay,
+// which is the longest interval over which no remote spike can arrive late.
+// Every rank runs the same construction calls with global ids; each keeps only its own part.
+class DistributedNetwork {
+public:
+    explicit DistributedNetwork(MPI_Comm comm = MPI_COMM_WORLD);
+
+    void add_neuron_population(size_t size, std::shared_ptr<Neuron> neuron_type);
+    // Stored by the rank owning the source, ignored by the others
+    void add_synapse(const Synapse& synapse);
+    // Kept by the rank owning the neuron
+    void schedule_spike_event(double time, size_t neuron_index, double weight);
+
+    // Collective - all ranks must call it with the same T
+    void run(double T);
+
+    // Collective - spikes of all ranks as (time, global id), sorted, on root (empty elsewhere)
+    std::vector<std::pair<double, size_t>> gather_spikes(int root = 0);
+    // Collective - one state variable of a population in global order, on root (empty elsewhere)
+    std::vector<double> gather_population_state(size_t population, size_t var, int root = 0);
+    void reset_spikes();
+
+    size_t size() const;
+    int owner(size_t neuron_index) const;
+    bool is_local(size_t neuron_index) const;
+    // Global <-> local index of the neurons owned by this rank
+    size_t to_local(size_t neuron_index) const;
+    size_t to_global(size_t local_index) const;
+
+    NeuralNetwork& local() { return local_; }
+    int rank() const { return rank_; }
+    int num_ranks() const { return n_ranks_; }
+    double sim_time() const { return local_.sim_time; }
+
+private:
+    struct Partition {
+        size_t global_first;               // First global id of the population
+        size_t size;                       // Global size
+        std::vector<size_t> local_first;   // First local id of the block of every rank
+        int local_population;              // Population index in local_ (-1 if this rank's block is empty)
+    };
+    // Synapse to a neuron of another rank
+    struct RemoteSynapse {
+        int rank;
+        size_t target;         // Local id on the target rank
+        double weight;
+        double delay;
+    };
+    // Spike delivery sent between ranks
+    struct WireEvent {
+        double time;
+        double weight;
+        uint64_t target;
+    };
+
+    size_t block_begin(const Partition& p, int rank) const { return p.size * rank / n_ranks_; }
+    const Partition& partition_of(size_t neuron_index) const;
+    // Local id, on the owning rank, of a global neuron
+    size_t local_index_on(const Partition& p, size_t neuron_index, int rank) const;
+    double min_remote_delay();
+    void exchange();
+
+    MPI_Comm comm_;
+    int rank_;
+    int n_ranks_;
+    NeuralNetwork local_;
+    std::vector<Partition> partitions_;
+    size_t global_size_;
+
+    std::vector<std::vector<RemoteSynapse>> remote_rows_;   // Per local source
+    double local_min_delay_;   // Minimum delay of this rank's remote synapses
+
+    std::shared_ptr<SpikeMonitor> outbox_;                    // Local spikes of the current epoch
+    std::vector<std::pair<double, size_t>> spikes_;           // Recorded local spikes (global ids)
+    std::vector<std::vector<WireEvent>> send_buffers_;
+    std::vector<WireEvent> send_flat_, recv_flat_;
+    std::vector<int> send_counts_, recv_counts_, send_displs_, recv_displs_;
+};
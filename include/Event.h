@@ -1,6 +1,11 @@
 #pragma once
 
 #include <variant>
+#include <vector>
+#include <algorithm>
+#include <limits>
+#include <cstddef>
+#include <cstdint>
 
 struct SpikeEvent {
     double time;
@@ -12,7 +17,41 @@ struct UpdateEvent {
     double time;
 };
 
-using Event = std::variant<SpikeEvent, UpdateEvent>;
+// Pending spike of a SpikeGenerator source - stale if the generator rescheduled that source
+struct GeneratorEvent {
+    double time;
+    size_t generator_index;
+    size_t source_index;
+};
+
+// Threshold crossing predicted by the neuron model - stale if the neuron was perturbed since
+struct SelfSpikeEvent {
+    double time;
+    size_t neuron_index;
+};
+
+// End of the gathering window of a batched population - stale if the batch was flushed earlier
+struct BatchEvent {
+    double time;
+    size_t population;
+};
+
+// Spike of a source reaching one delay group of its outgoing synapses - expanded into deliveries when popped
+struct PacketEvent {
+    double time;
+    size_t group;
+};
+
+// Delay group of a projection (see Projection::num_groups) reaching its targets - generated when popped
+struct ProjectionPacketEvent {
+    double time;
+    uint32_t projection;
+    uint32_t group;
+    size_t source;
+};
+
+using Event = std::variant<SpikeEvent, UpdateEvent, GeneratorEvent, SelfSpikeEvent, BatchEvent, PacketEvent,
+                           ProjectionPacketEvent>;
 
 // Needed to stablish priority in the event queue - time field is obligatory
 struct EventCompare {
@@ -20,4 +59,142 @@ struct EventCompare {
         auto get_time = [](const auto& ev) { return ev.time; };
         return std::visit(get_time, a) > std::visit(get_time, b);
     }
-};
\ No newline at end of file
+};
+
+// Time-ordered event queue: a binary heap for arbitrary events plus FIFO lanes for spike packets.
+// Packets sent through one lane (one synapse delay) are emitted in non-decreasing time order, so the lane
+// stays sorted and push/pop are O(1) - the next event is the earliest of the heap top and the lane heads.
+// A packet that would break the order of its lane (e.g. a spike emitted by a batch flush) goes to the heap.
+// Storage is kept across runs and the heap can be reserved up front.
+class EventQueue {
+public:
+    static constexpr uint32_t NO_LANE = std::numeric_limits<uint32_t>::max();
+
+    void push(const Event& ev) {
+        heap_.push_back(ev);
+        std::push_heap(heap_.begin(), heap_.end(), EventCompare());
+    }
+
+    void push(const PacketEvent& ev, uint32_t lane) {
+        if (lane >= lanes_.size() || lanes_[lane].out_of_order(ev.time)) {
+            push(Event(ev));
+            return;
+        }
+        lanes_[lane].push(ev);
+        ++lane_events_;
+    }
+
+    bool empty() const { return heap_.empty() && lane_events_ == 0; }
+    size_t size() const { return heap_.size() + lane_events_; }
+
+    // Time of the earliest event - the queue must not be empty
+    double next_time() const {
+        size_t lane = earliest_lane();
+        if (lane != lanes_.size() && (heap_.empty() || lanes_[lane].front().time < heap_time()))
+            return lanes_[lane].front().time;
+        return heap_time();
+    }
+
+    // Removes and returns the earliest event - the queue must not be empty
+    Event pop() {
+        size_t lane = earliest_lane();
+        if (lane != lanes_.size() && (heap_.empty() || lanes_[lane].front().time < heap_time())) {
+            --lane_events_;
+            return lanes_[lane].pop();
+        }
+        std::pop_heap(heap_.begin(), heap_.end(), EventCompare());
+        Event ev = heap_.back();
+        heap_.pop_back();
+        return ev;
+    }
+
+    // Removes every queued packet - used before the delay groups they refer to are rebuilt
+    std::vector<PacketEvent> take_packets() {
+        std::vector<PacketEvent> packets;
+        for (auto& lane : lanes_)
+            while (!lane.empty()) packets.push_back(lane.pop());
+        lane_events_ = 0;
+        auto is_packet = [](const Event& ev) { return std::holds_alternative<PacketEvent>(ev); };
+        for (const auto& ev : heap_)
+            if (is_packet(ev)) packets.push_back(std::get<PacketEvent>(ev));
+        heap_.erase(std::remove_if(heap_.begin(), heap_.end(), is_packet), heap_.end());
+        std::make_heap(heap_.begin(), heap_.end(), EventCompare());
+        return packets;
+    }
+
+    // Drops every queued event - the storage and the lanes are kept
+    void clear() {
+        heap_.clear();
+        for (auto& lane : lanes_) lane.clear();
+        lane_events_ = 0;
+    }
+
+    // Applies f to every event of the heap (packets in lanes are not visited) - f must not change times
+    template <class F>
+    void for_each_event(F&& f) {
+        for (auto& ev : heap_) f(ev);
+    }
+
+    // Lanes are only ever added - packets still queued in a lane stay valid
+    void set_num_lanes(size_t n) { if (n > lanes_.size()) lanes_.resize(n); }
+    size_t num_lanes() const { return lanes_.size(); }
+
+    void reserve(size_t n) { heap_.reserve(n); }
+    size_t capacity() const { return heap_.capacity(); }
+
+private:
+    // Ring buffer of packets in time order - the capacity is a power of two and only grows
+    class Lane {
+    public:
+        bool out_of_order(double time) const { return count_ > 0 && time < back_time_; }
+        const PacketEvent& front() const { return buf_[head_]; }
+        bool empty() const { return count_ == 0; }
+        void clear() { head_ = count_ = 0; }
+
+        void push(const PacketEvent& ev) {
+            if (count_ == buf_.size()) grow();
+            buf_[(head_ + count_) & (buf_.size() - 1)] = ev;
+            ++count_;
+            back_time_ = ev.time;
+        }
+
+        PacketEvent pop() {
+            PacketEvent ev = buf_[head_];
+            head_ = (head_ + 1) & (buf_.size() - 1);
+            --count_;
+            return ev;
+        }
+
+    private:
+        void grow() {
+            std::vector<PacketEvent> buf(buf_.empty() ? 64 : 2 * buf_.size());
+            for (size_t i = 0; i < count_; ++i) buf[i] = buf_[(head_ + i) & (buf_.size() - 1)];
+            buf_.swap(buf);
+            head_ = 0;
+        }
+
+        std::vector<PacketEvent> buf_;
+        size_t head_ = 0;
+        size_t count_ = 0;
+        double back_time_ = 0.0;
+    };
+
+    double heap_time() const {
+        return std::visit([](const auto& ev) { return ev.time; }, heap_.front());
+    }
+
+    // Lane with the earliest head (lanes_.size() if all are empty) - K is small, a linear scan is fastest
+    size_t earliest_lane() const {
+        size_t best = lanes_.size();
+        if (lane_events_ == 0) return best;
+        for (size_t l = 0; l < lanes_.size(); ++l) {
+            if (lanes_[l].empty()) continue;
+            if (best == lanes_.size() || lanes_[l].front().time < lanes_[best].front().time) best = l;
+        }
+        return best;
+    }
+
+    std::vector<Event> heap_;
+    std::vector<Lane> lanes_;
+    size_t lane_events_ = 0;
+};
@@ -0,0 +1,47 @@
+#pragma once
+#include "MultiStateNeuron.h"
+
+// LIF neuron with an exponentially decaying synaptic current
+// State variables: 0 - membrane potential v, 1 - synaptic current I
+//   C_m dv/dt = -C_m (v - v_rest) / tau_m + I,   dI/dt = -I / tau_syn
+// An incoming charge q adds q / tau_syn to I, so the current integrates to q.
+// Threshold crossings between inputs are predicted (peak of the trajectory, then bisection) and scheduled
+// by the network as events.
+class ExpCurrentLIFNeuron : public MultiStateNeuron {
+public:
+    ExpCurrentLIFNeuron(double tau_m = 0.02, // [s]
+                        double tau_syn = 0.005, // [s]
+                        double C_m = 1e-6, // [F]
+                        double v_rest = 0.07, // [V]
+                        double v_reset = 0.07, // [V]
+                        double v_thresh = 0.05, // [V]
+                        double refractory = 0.002 // [s]
+    );
+
+    size_t get_num_state_vars() override;
+    double get_init_state(size_t var) override;
+    void decay_vars(double t, double* const* vars, double* last_spike, double* last_update, size_t n) override;
+    bool receive_vars(double t, double charge, double* const* vars, double* last_spike, double* last_update) override;
+
+    // Per-neuron parameters: vars[2 + p] follows the order of get_param_names
+    enum Param { TAU_M, TAU_SYN, C_M, V_REST, V_RESET, V_THRESH, REFRACTORY, NUM_PARAMS };
+    std::vector<std::string> get_param_names() override;
+    double get_param_value(size_t p) override;
+
+    bool predicts_spikes(double* const* vars, size_t n) override;
+    double next_spike_time(double* const* vars, double* last_spike, double* last_update) override;
+    bool fire_vars(double t, double* const* vars, double* last_spike, double* last_update) override;
+
+    // Public variable to make acess easier from Python
+    double tau_m_;
+    double tau_syn_;
+    double C_m_;
+    double v_rest_;
+    double v_reset_;
+    double v_thresh_;
+    double refractory_;
+
+private:
+    template<bool Heterogeneous>
+    void decay_kernel(double t, double* const* vars, double* last_spike, double* last_update, size_t n);
+};
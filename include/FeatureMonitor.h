@@ -0,0 +1,35 @@
+#pragma once
+#include <vector>
+#include <cstddef>
+
+// Builds readout features for a contiguous range of neurons during run():
+// - counts: spikes per time bin
+// - traces: spike trains (impulses of 1/bin_width) filtered by a causal exponential kernel exp(-t/tau),
+//           sampled once per bin - only maintained if tau > 0
+// Both buffers are row-major (n_bins x n_neurons) and preallocated, bin 0 starting at the first run
+// after construction or reset. Spikes past the last bin are ignored.
+class FeatureMonitor {
+public:
+    FeatureMonitor(size_t first_neuron, size_t n_neurons, double bin_width, size_t n_bins, double tau = 0.0);
+
+    void on_spike(double time, size_t neuron_id);
+    // Called by the network around each run
+    void on_run_start(double time);
+    void on_run_end(double time);
+    void reset_recording();
+
+    // Public for direct access from python
+    std::vector<double> counts;
+    std::vector<double> traces;
+
+    size_t first_neuron_;
+    size_t n_neurons_;
+    double bin_width_;
+    size_t n_bins_;
+    double tau_;
+
+private:
+    bool started_;
+    double origin_;
+    size_t filtered_bins_;    // Bins before this index are final in traces
+};
@@ -0,0 +1,45 @@
+#pragma once
+#include "MultiStateNeuron.h"
+
+// Izhikevich (2003) neuron, with the original units: v and u in [mV], time in [ms] internally
+// State variables: 0 - membrane potential v, 1 - recovery variable u
+//   dv/dt = 0.04 v^2 + 5 v + 140 - u,   du/dt = a (b v - u)
+// Incoming charge is added directly to v [mV]. On a spike (v >= 30 mV) v = c and u += d.
+// Between events the equations are integrated with forward Euler steps of at most dt_int [s]. Crossings of the
+// peak without input (e.g. rebound spikes) are predicted by integrating ahead PREDICTION_STEPS steps at a time
+// until the neuron crosses or settles, and fire at the end of the crossing step.
+class IzhikevichNeuron : public MultiStateNeuron {
+public:
+    IzhikevichNeuron(double a = 0.02,
+                     double b = 0.2,
+                     double c = -65.0, // [mV]
+                     double d = 8.0,
+                     double dt_int = 1e-4 // [s]
+    );
+
+    size_t get_num_state_vars() override;
+    double get_init_state(size_t var) override;
+    void decay_vars(double t, double* const* vars, double* last_spike, double* last_update, size_t n) override;
+    bool receive_vars(double t, double charge, double* const* vars, double* last_spike, double* last_update) override;
+
+    // Per-neuron parameters: vars[2 + p] follows the order of get_param_names
+    enum Param { A, B, C, D, NUM_PARAMS };
+    std::vector<std::string> get_param_names() override;
+    double get_param_value(size_t p) override;
+
+    bool predicts_spikes(double* const* vars, size_t n) override;
+    double next_spike_time(double* const* vars, double* last_spike, double* last_update) override;
+    bool fire_vars(double t, double* const* vars, double* last_spike, double* last_update) override;
+
+    // Steps integrated ahead per prediction - a neuron still moving after them is predicted again
+    static constexpr size_t PREDICTION_STEPS = 64;
+
+    // Public variable to make acess easier from Python
+    double a_;
+    double b_;
+    double c_;
+    double d_;
+    double dt_int_;
+
+    static constexpr double V_PEAK = 30.0; // [mV]
+};
@@ -8,13 +8,27 @@ public:
               double v_rest = 0.07, // [V]
               double v_reset = 0.07, // [V]
               double v_thresh = 0.05, // [V]
-              double refractory = 0.002 // [s]
+              double refractory = 0.002, // [s]
+              double i_bias = 0.0 // [A], constant input current
     );
 
     void decay(double t, double* state, double* last_spike, double* last_update, size_t n) override;
     bool receive(double t, double charge, double* state, double* last_spike, double* last_update) override;
     double get_init_value() override;
 
+    // Per-neuron parameters: vars[1 + p] follows the order of get_param_names
+    enum Param { TAU_M, C_M, V_REST, V_RESET, V_THRESH, REFRACTORY, I_BIAS, NUM_PARAMS };
+    std::vector<std::string> get_param_names() override;
+    double get_param_value(size_t p) override;
+    // Only used for heterogeneous populations
+    void decay_vars(double t, double* const* vars, double* last_spike, double* last_update, size_t n) override;
+    bool receive_vars(double t, double charge, double* const* vars, double* last_spike, double* last_update) override;
+
+    // With a bias current the potential relaxes towards v_rest + R i_bias and may fire on its own
+    bool predicts_spikes(double* const* vars, size_t n) override;
+    double next_spike_time(double* const* vars, double* last_spike, double* last_update) override;
+    bool fire_vars(double t, double* const* vars, double* last_spike, double* last_update) override;
+
     // Public variable to make acess easier from Python
     double tau_m_;
     double C_m_;
@@ -23,4 +37,5 @@ public:
     double v_reset_;
     double v_thresh_;
     double refractory_;
+    double i_bias_;
 };
\ No newline at end of file
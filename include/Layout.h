@@ -0,0 +1,14 @@
+#pragma once
+#include <vector>
+#include <cstddef>
+#include "SynapseMatrix.h"
+
+// Reverse Cuthill-McKee order of the synapse graph, taken as undirected: order[k] is the neuron placed at
+// position k. Connected neurons end up at nearby positions, so the targets of a fan-out share cache lines.
+// Every connected component is started from its lowest-degree neuron; neighbours are visited by increasing degree.
+template <class Weight>
+std::vector<size_t> reverse_cuthill_mckee(const BasicSynapseMatrix<Weight>& synapses);
+
+// Half-bandwidth of the synapse matrix under a layout (position of each neuron) - max |pos(src) - pos(dst)|
+template <class Weight>
+size_t layout_bandwidth(const BasicSynapseMatrix<Weight>& synapses, const std::vector<size_t>& position);
@@ -0,0 +1,22 @@
+#pragma once
+#include <stdexcept>
+#include "Neuron.h"
+
+// Base class for models with more than one state variable - they only implement the *_vars kernels
+class MultiStateNeuron : public Neuron {
+public:
+    void decay(double t, double* state, double* last_spike, double* last_update, size_t n) override {
+        throw std::logic_error("Multi-state neuron: use decay_vars");
+    }
+    bool receive(double t, double charge, double* state, double* last_spike, double* last_update) override {
+        throw std::logic_error("Multi-state neuron: use receive_vars");
+    }
+    double get_init_value() override {
+        return get_init_state(0);
+    }
+
+    size_t get_num_state_vars() override = 0;
+    double get_init_state(size_t var) override = 0;
+    void decay_vars(double t, double* const* vars, double* last_spike, double* last_update, size_t n) override = 0;
+    bool receive_vars(double t, double charge, double* const* vars, double* last_spike, double* last_update) override = 0;
+};
@@ -2,44 +2,181 @@
 
 #include <vector>
 #include <memory>
+#include <cstdint>
+#include <string>
 #include <queue>
 #include "Neuron.h"
 #include "NeuronPopulation.h"
 #include "Synapse.h"
+#include "SynapseMatrix.h"
+#include "STDPRule.h"
+#include "Projection.h"
+#include "CompressedProjection.h"
+#include "Connectivity.h"
 #include "Event.h"
 #include "SpikeMonitor.h"
 #include "StateMonitor.h"
+#include "FeatureMonitor.h"
+#include "SpikeCountMonitor.h"
+#include "SpikeGenerator.h"
 
-// NeuralNetwork: event-driven simulation engine
-class NeuralNetwork {
+// NeuralNetwork: event-driven simulation engine.
+// Weight is the precision policy of the synapse storage: float weights with 32-bit targets and row index
+// (SynapseIndex), or double weights with size_t indices - 8 vs. 16 bytes read per delivered synapse.
+// Times, delays and neuron states are double in both builds, so event order is unaffected; neuron state stays
+// double because every model kernel shares the double* Neuron interface (see benchmarks/bench_precision).
+template <class Weight>
+class BasicNeuralNetwork {
 public:
     // Current simulation time - used when performing multiple runs
     double sim_time;
 
-    NeuralNetwork();
-    ~NeuralNetwork() = default;
+    BasicNeuralNetwork();
+    ~BasicNeuralNetwork() = default;
 
     void add_neuron_population(size_t size, std::shared_ptr<Neuron> neuron_type);
 
+    // Adds a population of input neurons driven by the generator (one neuron per source)
+    void add_input_population(std::shared_ptr<SpikeGenerator> generator);
+
     void add_synapse(const Synapse& synapse);
 
+    // Synapses in storage order (grouped by source neuron, sorted by delay within a source)
+    std::vector<Synapse> get_synapses();
+
+    // Native connectivity generators between populations - synapses are staged like add_synapse.
+    // Deterministic for a given seed regardless of the number of threads; return the number of synapses created
+    size_t connect_random(size_t pre_pop, size_t post_pop, double p, const Distribution& weight, const Distribution& delay,
+                          uint64_t seed = 0, bool allow_autapses = true);
+    size_t connect_fixed_outdegree(size_t pre_pop, size_t post_pop, size_t k, const Distribution& weight, const Distribution& delay,
+                                   uint64_t seed = 0, bool allow_autapses = true);
+    size_t connect_fixed_indegree(size_t pre_pop, size_t post_pop, size_t k, const Distribution& weight, const Distribution& delay,
+                                  uint64_t seed = 0, bool allow_autapses = true);
+    // Positions are (x, y, z) per neuron of each population, e.g. from grid_positions
+    size_t connect_distance(size_t pre_pop, size_t post_pop,
+                            const std::vector<double>& pre_positions, const std::vector<double>& post_positions,
+                            double C, double lambda, const Distribution& weight, const Distribution& delay,
+                            uint64_t seed = 0, bool allow_autapses = true);
+    size_t connect_small_world(size_t pop, size_t k, double beta, const Distribution& weight, const Distribution& delay,
+                               uint64_t seed = 0);
+
+    // Bulk access to the stored synapses, in the order of get_synapses (stable until synapses are added).
+    // The references stay valid until the next add_synapse/connect_* call is built into the storage.
+    // Delays are read-only: set_delays validates them and regroups the synapses by delay
+    size_t num_synapses();
+    std::vector<Weight>& get_weights();
+    const std::vector<double>& get_delays();
+    void set_weights(const std::vector<Weight>& weights);
+    void set_delays(const std::vector<double>& delays);
+    // Multiplies the weights of every stored synapse from population pre_pop to population post_pop
+    void scale_weights(size_t pre_pop, size_t post_pop, double factor);
+
+    // Plasticity - the rule updates the weights of the synapses in its projection during run()
+    void add_stdp_rule(std::shared_ptr<STDPRule> rule);
+
+    // Procedural connectivity - synapses are regenerated on every spike of a source, not stored
+    void add_projection(std::shared_ptr<Projection> projection);
+    // Moves the staged synapses from pre_pop to post_pop into a compressed projection (quantized weights,
+    // delta-encoded targets, delay table) and returns it - for connectivity too large for the CSR storage
+    std::shared_ptr<CompressedProjection> compress_synapses(size_t pre_pop, size_t post_pop,
+                                                            CompressedProjection::WeightBits bits = CompressedProjection::WeightBits::Int8,
+                                                            double weight_scale = 0.0);
+
     // Schedule external input event
     void schedule_spike_event(double time, size_t neuronIndex, double weight);
+    // Same, with time given as absolute simulation time instead of relative to sim_time
+    void schedule_absolute_spike_event(double time, size_t neuron_index, double weight);
+    // Bulk input between steps - times relative to sim_time. Nothing is queued if an index is out of bounds
+    void schedule_spike_events(const std::vector<double>& times, const std::vector<size_t>& neuron_indices,
+                               const std::vector<double>& weights);
+    // Pre-sizes the event queue - its storage is kept across runs
+    void reserve_events(size_t n);
+    // Spike packets go through one FIFO per delay when the stored synapses have at most k distinct delays,
+    // otherwise (or with k = 0) through the general priority queue
+    void set_max_delay_lanes(size_t k);
 
     void set_spike_monitor(std::shared_ptr<SpikeMonitor> monitor);
     void set_state_monitor(std::shared_ptr<StateMonitor> monitor);
+    void set_feature_monitor(std::shared_ptr<FeatureMonitor> monitor);
+    void set_spike_count_monitor(std::shared_ptr<SpikeCountMonitor> monitor);
+    // Second spike sink for spikes leaving the engine (e.g. sent to other processes) - independent of the spike monitor
+    void set_export_monitor(std::shared_ptr<SpikeMonitor> monitor);
+
+    // Renumbers the neurons of every population in reverse Cuthill-McKee order of the synapse graph, so that
+    // connected neurons sit close together in the state arrays. Ids seen through the API and the monitors stay
+    // the user's ones; only the storage order (get_synapses, get_weights, get_delays) changes.
+    // Input populations and populations partially covered by an STDP rule keep their order.
+    // Must be called before the first run - synapses added later are mapped to the new layout.
+    void optimize_layout();
+    // Storage position -> user id of every neuron (identity unless optimize_layout was called)
+    std::vector<size_t> get_layout() const;
 
     void set_num_exec_threads(size_t n);
     size_t get_num_exec_threads() const;
 
-    // Run simulation until time T
+    // Run simulation until time T (relative to sim_time)
     void run(double T);
+    // Resumable chunked runs for closed loops - advances to the absolute time t. Queued events, the state
+    // monitor schedule and the monitor windows carry over between calls. Predicted spikes are only refreshed
+    // after changes through the network API or to the parameters of a model, so the per-call overhead does
+    // not grow with the network size
+    void run_until(double t);
+    // Advances by the interval set with set_step
+    void step();
+    void set_step(double dt);
+    double get_step() const;
 
     void reset_monitors();
+    // Back to time 0 for another trial on the same network: initial neuron states, no queued events (scheduled
+    // inputs included), no gathered batches, STDP traces and monitors cleared, generators restarted.
+    // Synapses, weights (plastic changes included), parameters and attached monitors are kept, so without
+    // plasticity a reset network repeats the runs of a freshly built one without rebuilding the synapse storage
+    void reset();
 
     size_t size() const;
 
+    // Copy of one state variable of a population (variable 0 is also recorded by StateMonitor)
+    std::vector<double> get_population_state(size_t population, size_t var) const;
+
+    // Per-neuron parameters (heterogeneous populations) - see Neuron::get_param_names for the supported names
+    void set_population_param(size_t population, const std::string& name, const std::vector<double>& values);
+    std::vector<double> get_population_param(size_t population, const std::string& name) const;
+
 private:
+    // User id <-> storage position of a neuron
+    size_t to_internal(size_t neuron_index) const { return to_internal_.empty() ? neuron_index : to_internal_[neuron_index]; }
+    size_t to_external(size_t neuron_index) const { return to_external_.empty() ? neuron_index : to_external_[neuron_index]; }
+    // Moves every neuron to position inverse[current position] - synapses, queued events and state follow
+    void apply_layout(const std::vector<size_t>& perm);
+
+    const NeuronPopulation& population_at(size_t population) const;
+    // Brings the target up to time t and delivers the charge - returns true if it fired
+    bool deliver(double t, size_t neuron_index, double weight);
+    // Emits a spike of neuron_index at time t - monitors and post-synaptic events
+    void fire(double t, size_t neuron_index);
+    // Moves staged synapses into the CSR storage
+    void build_synapses();
+    // Maps every delay group to the FIFO lane of its delay (NO_LANE past max_delay_lanes_ distinct delays)
+    void assign_delay_lanes();
+    // Turns queued packets into individual spike events - their delay groups are about to change
+    void expand_queued_packets();
+    // Queues the first spike of every generator whose rates changed since the last run
+    void arm_generators();
+    // Refreshes the predicted threshold crossings of populations that can fire without input
+    void arm_predictions();
+    // Sets the gathering window of batched populations from the minimum delay of their outgoing synapses
+    void arm_batches();
+    // Runs the model over the gathered inputs of a batched population and emits the resulting spikes
+    void flush_batch(NeuronPopulation& pop);
+    void flush_batches();
+    // Batched populations emit their spikes when the batch is flushed, after later events may have been
+    // processed - throws std::logic_error if an STDP rule or a windowed monitor would see them out of order
+    void check_batched_populations() const;
+    // Queues the next predicted crossing of a neuron if it changed - the previous event becomes stale
+    void schedule_predicted_spike(const NeuronPopulation& pop, size_t neuron_index, double* const* vars);
+    // Brings every neuron to time t and records the state monitor reading
+    void update_states(double t);
+
     // Each population may have different types (properties)
     std::vector<std::unique_ptr<NeuronPopulation>> neuron_populations_; 
     // State vectors aggregate all populations - exploiting cache locality
@@ -48,14 +185,59 @@ private:
     std::vector<double> neuron_states_;
     // Fast (O(1)) lookup to neuron types
     std::vector<std::shared_ptr<Neuron>> neuron_types_;
+    // Population of each neuron - used to reach the state variables of multi-state models
+    std::vector<uint32_t> neuron_population_ids_;
+    // Pending predicted spike of each neuron (infinity if none)
+    std::vector<double> neuron_predicted_spikes_;
+    // Batched populations currently gathering inputs
+    size_t pending_batches_;
+    // Predictions and batch windows match the network - cleared by API changes that affect them
+    bool armed_;
+    double step_;
+    // Layout maps (empty while neurons are stored in id order) and the state vector in id order for the state monitor
+    std::vector<size_t> to_internal_;
+    std::vector<size_t> to_external_;
+    std::vector<double> external_states_;
 
+    // Synapses added since the last run are staged per source neuron, then moved to CSR storage
     std::vector<std::vector<Synapse>> adjacency_;
-    std::priority_queue<Event, std::vector<Event>, EventCompare> event_queue_;
+    size_t staged_synapses_;
+    BasicSynapseMatrix<Weight> synapses_;
+    // Delays were changed by set_delays - the delay groups are rebuilt before the next run
+    bool delay_groups_stale_;
+    size_t max_delay_lanes_;
+    std::vector<uint32_t> group_lanes_;
+    std::vector<std::shared_ptr<STDPRule>> stdp_rules_;
+    std::vector<std::shared_ptr<Projection>> projections_;
+    // Scratch buffers for generated synapses - reused across spikes and projection packets
+    std::vector<Synapse> generated_synapses_;
+    std::vector<Synapse> packet_synapses_;
+    EventQueue event_queue_;
+
+    // Input generators and the index of the first neuron of their population
+    std::vector<std::shared_ptr<SpikeGenerator>> generators_;
+    std::vector<size_t> generator_offsets_;
 
     // Monitors (optional)
     std::shared_ptr<SpikeMonitor> spike_monitor_;
     std::shared_ptr<StateMonitor> state_monitor_;
+    std::shared_ptr<FeatureMonitor> feature_monitor_;
+    std::shared_ptr<SpikeCountMonitor> spike_count_monitor_;
+    std::shared_ptr<SpikeMonitor> export_monitor_;
+    // State monitor schedule: a single queued UpdateEvent, requeued when handled. Readings fall on
+    // reading_origin_ + k * interval; queued UpdateEvents at any other time than next_reading_ are stale
+    bool readings_armed_;
+    double reading_origin_;
+    uint64_t reading_count_;
+    double next_reading_;
 
     // Sets the number of threads for parallel sections
     size_t num_exec_threads_;
-};
\ No newline at end of file
+};
+
+// Both precisions are instantiated in NeuralNetwork.cpp
+extern template class BasicNeuralNetwork<float>;
+extern template class BasicNeuralNetwork<double>;
+
+using NeuralNetwork = BasicNeuralNetwork<double>;
+using NeuralNetworkF32 = BasicNeuralNetwork<float>;
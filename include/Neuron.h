@@ -1,7 +1,8 @@
 #pragma once
 
-#include <pybind11/pybind11.h>
-#include <pybind11/numpy.h>
+#include <string>
+#include <vector>
+#include <limits>
 
 // We take a mixed strategy, the neuron performs fixed operations over a fixed size array - we do this because we want SIMD operations
 // Advantage of a contiguous representation - cache
@@ -20,37 +21,41 @@ public:
 
     // Must return the value to which the neuron is initialized
     virtual double get_init_value()=0;
-};
-
 
-// Trampoline class for Python overrides
-class PyNeuron : public Neuron {
-public:
-    using Neuron::Neuron;
-
-    void decay(double t, double* state, double* last_spike, double* last_update, size_t n) override {
-        PYBIND11_OVERRIDE_PURE(
-            void,
-            Neuron,
-            decay,
-            t, state, last_spike, last_update, n
-        );
+    // Multi-state models declare K state variables, each stored by the network as its own contiguous
+    // array per population. Variable 0 is the primary state (e.g. membrane potential) - the one
+    // single-state models work on and the one recorded by StateMonitor.
+    virtual size_t get_num_state_vars() { return 1; }
+    virtual double get_init_state(size_t var) { return var == 0 ? get_init_value() : 0.0; }
+
+    // Parameters that may be set per neuron. A population with per-neuron values stores one array per
+    // parameter next to its state; the kernels then find parameter p in vars[K + p]. For homogeneous
+    // populations those entries are null and the scalar members are used instead.
+    virtual std::vector<std::string> get_param_names() { return {}; }
+    // Population-level value of parameter p, used to fill the arrays
+    virtual double get_param_value(size_t p) { return 0.0; }
+
+    // Kernels over all state variables: vars[k] points to the k-th state array, offset to the first neuron
+    // By default they forward to the single-state kernels
+    virtual void decay_vars(double t, double* const* vars, double* last_spike, double* last_update, size_t n) {
+        decay(t, vars[0], last_spike, last_update, n);
     }
-
-    bool receive(double t, double charge, double* state, double* last_spike, double* last_update) override {
-        PYBIND11_OVERRIDE_PURE(
-            bool,
-            Neuron,
-            receive,
-            t, charge, state, last_spike, last_update
-        );
+    virtual bool receive_vars(double t, double charge, double* const* vars, double* last_spike, double* last_update) {
+        return receive(t, charge, vars[0], last_spike, last_update);
     }
 
-    double get_init_value() override {
-        PYBIND11_OVERRIDE_PURE(
-            double,
-            Neuron,
-            get_init_value
-        );
+    // Models that can cross threshold without input (e.g. driven by a bias current) predict the crossing
+    // (analytically, or by integrating ahead), so the network schedules it as an event instead of waiting
+    // for the next input. predicts_spikes receives the population table (vars over all n neurons) and is
+    // checked before each run.
+    virtual bool predicts_spikes(double* const* vars, size_t n) { return false; }
+    // Next threshold crossing given the state at last_update, assuming no further input (infinity if none).
+    // Models that integrate ahead over a bounded horizon may return the end of the horizon instead
+    virtual double next_spike_time(double* const* vars, double* last_spike, double* last_update) {
+        return std::numeric_limits<double>::infinity();
     }
-};
\ No newline at end of file
+    // Emits a predicted spike at time t - the state has already been brought up to t. Returns false if t was
+    // only the end of a prediction horizon (no crossing); the network then predicts again from t
+    virtual bool fire_vars(double t, double* const* vars, double* last_spike, double* last_update) { return false; }
+};
+
@@ -1,19 +1,78 @@
 // Here we instantiate a neural population composed of neurons of the same type, without including synapses.
 // This approach improves parallelism and cache locality.
+#pragma once
 #include <memory>
+#include <vector>
+#include <cstdint>
+#include <limits>
 #include "Neuron.h"
+#include "BatchedNeuron.h"
 
 struct NeuronPopulation {
+    // Upper bounds on the number of state variables and per-neuron parameters of a model
+    static constexpr size_t MAX_STATE_VARS = 8;
+    static constexpr size_t MAX_PARAMS = 8;
+
     NeuronPopulation(size_t n_neurons,
                      std::shared_ptr<Neuron> neuron_class,
                      double* state_addr,
                      double* last_spike_addr,
-                     double* last_update_addr)
-        : n_neurons(n_neurons),
-          neuron_class(std::move(neuron_class)), // Neuron class can only belong to a single population
-          state_addr(state_addr),
+                     double* last_update_addr,
+                     size_t first_index = 0)
+        : state_addr(state_addr),
           last_spike_addr(last_spike_addr),
-          last_update_addr(last_update_addr) {}
+          last_update_addr(last_update_addr),
+          n_neurons(n_neurons),
+          neuron_class(std::move(neuron_class)), // Neuron class can only belong to a single population
+          first_index(first_index) {
+        batched_class = dynamic_cast<BatchedNeuron*>(this->neuron_class.get());
+        // Variable 0 lives in the network state vector, the others are owned by the population
+        n_state_vars = this->neuron_class->get_num_state_vars();
+        n_params = this->neuron_class->get_param_names().size();
+        extra_states.resize(n_state_vars - 1);
+        for (size_t k = 1; k < n_state_vars; ++k)
+            extra_states[k - 1].assign(n_neurons, this->neuron_class->get_init_state(k));
+        update_state_vars();
+    }
+
+    // Refreshes the pointer table - must be called whenever state_addr changes
+    void update_state_vars() {
+        state_vars.assign(n_state_vars + n_params, nullptr);
+        state_vars[0] = state_addr;
+        for (size_t k = 1; k < n_state_vars; ++k)
+            state_vars[k] = extra_states[k - 1].data();
+        for (size_t p = 0; p < param_arrays.size(); ++p)
+            state_vars[n_state_vars + p] = param_arrays[p].data();
+        uses_state_vars = n_state_vars > 1 || !param_arrays.empty();
+    }
+
+    // Switches to per-neuron parameters, initialized with the population-level values
+    void make_heterogeneous() {
+        if (!param_arrays.empty()) return;
+        param_arrays.resize(n_params);
+        for (size_t p = 0; p < n_params; ++p)
+            param_arrays[p].assign(n_neurons, neuron_class->get_param_value(p));
+        update_state_vars();
+    }
+
+    // Records the model-level parameter values - returns true if any changed since the last call
+    // (e.g. a bias edited directly on the model object)
+    bool model_params_changed() {
+        bool changed = armed_params.size() != n_params;
+        armed_params.resize(n_params);
+        for (size_t p = 0; p < n_params; ++p) {
+            double value = neuron_class->get_param_value(p);
+            if (value != armed_params[p]) changed = true;
+            armed_params[p] = value;
+        }
+        return changed;
+    }
+
+    // Pointers to all state variables and parameters of one neuron (index relative to the population)
+    void neuron_state_vars(size_t i, double** vars) const {
+        for (size_t k = 0; k < state_vars.size(); ++k)
+            vars[k] = state_vars[k] ? state_vars[k] + i : nullptr;
+    }
 
     // Address in the AoS where the states start
     double* state_addr;
@@ -22,4 +81,23 @@ struct NeuronPopulation {
 
     size_t n_neurons;     // Number of neurons (state array size)
     std::shared_ptr<Neuron> neuron_class;  // Neuron class - defines computational model and parameters
-};
\ No newline at end of file
+
+    size_t first_index;   // Network index of the first neuron
+    size_t n_state_vars;  // State variables per neuron (K)
+    std::vector<std::vector<double>> extra_states;  // SoA arrays for variables 1..K-1
+    size_t n_params;      // Per-neuron parameters supported by the model (P)
+    std::vector<std::vector<double>> param_arrays;  // SoA parameter arrays - empty for homogeneous populations
+    std::vector<double*> state_vars;                // Start of every state and parameter array (K + P entries)
+    bool uses_state_vars; // Kernels must be called through decay_vars/receive_vars
+    bool predicts_spikes = false; // Threshold crossings are scheduled by the network (refreshed on changes)
+    std::vector<double> armed_params; // Model parameters when the predictions were last refreshed
+
+    // Batched models (null otherwise): inputs gathered until batch_flush_time, buffers reused across batches
+    BatchedNeuron* batched_class;
+    double batch_window = 0.0;
+    double batch_flush_time = std::numeric_limits<double>::infinity();
+    std::vector<size_t> batch_targets;
+    std::vector<double> batch_times;
+    std::vector<double> batch_charges;
+    std::vector<uint8_t> batch_fired;
+};
@@ -0,0 +1,33 @@
+#pragma once
+#include <cstdint>
+#include "Projection.h"
+#include "CounterRNG.h"
+
+// Random connectivity regenerated on every spike from a counter-based RNG seeded by (seed, source id),
+// so a source always gets the same targets, weights and delays without storing them.
+// Weights and delays are uniform in [w_min, w_max] and [d_min, d_max].
+class ProceduralProjection : public Projection {
+public:
+    enum class Connectivity {
+        FixedProbability,   // each (pre, post) pair connected with probability p
+        FixedOutDegree      // k distinct targets per source
+    };
+
+    ProceduralProjection(size_t pre_begin, size_t n_pre, size_t post_begin, size_t n_post,
+                         Connectivity connectivity, double p_or_k,
+                         double w_min, double w_max, double d_min, double d_max,
+                         uint64_t seed = 0, bool allow_autapses = true);
+
+    void generate(size_t neuron_id, std::vector<Synapse>& out) const override;
+    void scale_weights(double factor) override;
+    double min_delay() const override { return d_min_; }
+
+    Connectivity connectivity_;
+    double p_or_k_;
+    double w_min_;
+    double w_max_;
+    double d_min_;
+    double d_max_;
+    CounterRNG rng_;
+    bool allow_autapses_;
+};
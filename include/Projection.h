@@ -0,0 +1,35 @@
+#pragma once
+#include <vector>
+#include <cstddef>
+#include "Synapse.h"
+
+// Connectivity from [pre_begin, pre_begin + n_pre) to [post_begin, post_begin + n_post) whose synapses are
+// produced when the source fires instead of being kept in the CSR storage - computed from the projection
+// description, or decoded from a compact encoding.
+class Projection {
+public:
+    Projection(size_t pre_begin, size_t n_pre, size_t post_begin, size_t n_post)
+        : pre_begin_(pre_begin), n_pre_(n_pre), post_begin_(post_begin), n_post_(n_post) {}
+    virtual ~Projection() = default;
+
+    bool is_source(size_t neuron_id) const { return neuron_id - pre_begin_ < n_pre_; }
+
+    // Appends the outgoing synapses of a source (network index) to out - must be deterministic
+    virtual void generate(size_t neuron_id, std::vector<Synapse>& out) const = 0;
+    // Multiplies every generated weight
+    virtual void scale_weights(double factor) = 0;
+    // Smallest delay of the generated synapses
+    virtual double min_delay() const = 0;
+
+    // Packet delivery (optional): projections storing the synapses of a source in delay groups report them here,
+    // and the network queues one event per group, generated on arrival, instead of one per synapse.
+    // 0 groups means the synapses are generated when the source fires
+    virtual size_t num_groups(size_t neuron_id) const { return 0; }
+    virtual double group_delay(size_t neuron_id, size_t group) const { return 0.0; }
+    virtual void generate_group(size_t neuron_id, size_t group, std::vector<Synapse>& out) const {}
+
+    size_t pre_begin_;
+    size_t n_pre_;
+    size_t post_begin_;
+    size_t n_post_;
+};
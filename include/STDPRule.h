@@ -0,0 +1,61 @@
+#pragma once
+#include <vector>
+#include <cstddef>
+#include "SynapseMatrix.h"
+
+// Spike-timing dependent plasticity on the synapses from [pre_begin, pre_begin + n_pre) to
+// [post_begin, post_begin + n_post). Triplet rule of Pfister & Gerstner (2006), all-to-all interactions:
+//   pre spike:  w -= o1 (A2_minus + A3_minus r2),  then r1 += 1, r2 += 1
+//   post spike: w += r1 (A2_plus + A3_plus o2),    then o1 += 1, o2 += 1
+// With A3_plus = A3_minus = 0 (the default) it reduces to pair-based STDP.
+// Traces are stored per neuron and decayed lazily from their last update, so the cost is proportional
+// to spikes x fan-in/out. Spike times are taken at emission (synaptic delays are ignored).
+class STDPRule {
+public:
+    STDPRule(size_t pre_begin, size_t n_pre, size_t post_begin, size_t n_post,
+             double tau_plus = 16.8e-3, // [s], pre trace r1
+             double tau_minus = 33.7e-3, // [s], post trace o1
+             double A2_plus = 5e-3,
+             double A2_minus = 7e-3,
+             double w_min = 0.0,
+             double w_max = 1.0
+    );
+
+    // Enables the triplet terms
+    void set_triplet(double tau_x, double tau_y, double A3_plus, double A3_minus);
+
+    // Called by the network when a neuron fires
+    template <class Weight>
+    void on_pre_spike(double t, size_t neuron_id, BasicSynapseMatrix<Weight>& synapses);
+    template <class Weight>
+    void on_post_spike(double t, size_t neuron_id, BasicSynapseMatrix<Weight>& synapses);
+    void reset_traces();
+
+    bool is_pre(size_t neuron_id) const { return neuron_id - pre_begin_ < n_pre_; }
+    bool is_post(size_t neuron_id) const { return neuron_id - post_begin_ < n_post_; }
+
+    // Public variable to make acess easier from Python
+    size_t pre_begin_;
+    size_t n_pre_;
+    size_t post_begin_;
+    size_t n_post_;
+    double tau_plus_;
+    double tau_minus_;
+    double tau_x_;
+    double tau_y_;
+    double A2_plus_;
+    double A2_minus_;
+    double A3_plus_;
+    double A3_minus_;
+    double w_min_;
+    double w_max_;
+
+private:
+    // Decays the traces of a neuron to time t
+    void decay_pre(size_t i, double t);
+    void decay_post(size_t j, double t);
+
+    // SoA traces, indexed relative to the pre/post ranges
+    std::vector<double> r1_, r2_, pre_last_;
+    std::vector<double> o1_, o2_, post_last_;
+};
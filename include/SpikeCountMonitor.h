@@ -0,0 +1,47 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// Lightweight alternative to SpikeMonitor: one counter per neuron, so memory does not grow with run length.
+// With window > 0 it also keeps the counts of the current and of the last completed window
+// (windows aligned to the first run after construction or reset).
+class SpikeCountMonitor {
+public:
+    explicit SpikeCountMonitor(double window = 0.0);
+
+    // Inlined in the network fire path
+    void on_spike(double time, size_t neuron_id) {
+        ++counts[neuron_id];
+        if (window_ > 0.0) {
+            if (__builtin_expect(time >= window_end_, 0)) roll(time);
+            ++window_counts[neuron_id];
+        }
+    }
+
+    // Called by the network around each run
+    void resize(size_t n_neurons);
+    void on_run_start(double time);
+    void on_run_end(double time);
+    void reset_counts();
+
+    // Average rate [Hz] per neuron since the first run after reset
+    std::vector<double> get_rates() const;
+    // Rate [Hz] per neuron during the last completed window
+    std::vector<double> get_window_rates() const;
+    double get_window() const;
+
+    // Public for direct access from python
+    std::vector<uint64_t> counts;
+    std::vector<uint32_t> window_counts;        // Current (incomplete) window
+    std::vector<uint32_t> last_window_counts;   // Last completed window
+
+private:
+    void roll(double time);
+
+    double window_;
+    bool started_;
+    double start_time_;
+    double end_time_;
+    double window_end_;
+};
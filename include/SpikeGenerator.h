@@ -0,0 +1,53 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include "CounterRNG.h"
+
+// Generates input spike trains inside the engine. Each source keeps a single pending spike:
+// when it fires, the network asks for the next one, so the queue holds O(sources) entries.
+class SpikeGenerator {
+public:
+    enum class Mode {
+        Poisson,        // homogeneous Poisson process, one rate per source
+        Regular,        // one spike every 1/rate seconds
+        Inhomogeneous   // Poisson process with a piecewise-constant rate profile (thinning)
+    };
+
+    SpikeGenerator(size_t n_sources, Mode mode = Mode::Poisson, uint64_t seed = 0);
+
+    // One rate [Hz] per source (Poisson and Regular modes)
+    void set_rates(const std::vector<double>& rates);
+    // Row-major (n_bins x n_sources) rates [Hz], each row lasting bin_width seconds (Inhomogeneous mode)
+    void set_rate_profile(const std::vector<double>& rates, double bin_width);
+
+    // Called by the network at the start of a run - rate changes take effect from time t
+    bool needs_arming() const;
+    void arm(double t);
+    // Restarts the spike trains: no pending spikes and fresh draw counters, so the same trains are drawn again
+    void reset();
+
+    // Next spike of a source strictly after t (infinity if none); also stored as the pending spike
+    double next_spike_time(size_t source, double t);
+    // Pending spike time - queued events with a different time are stale and must be dropped
+    double pending_spike_time(size_t source) const;
+
+    size_t size() const;
+    Mode get_mode() const;
+
+private:
+    double rate_at(size_t source, double t) const;
+
+    size_t n_sources_;
+    Mode mode_;
+    CounterRNG rng_;
+    bool armed_;
+
+    std::vector<double> rates_;          // Poisson/Regular: n_sources, Inhomogeneous: n_bins * n_sources
+    std::vector<double> max_rates_;      // Upper bound per source used for thinning
+    double bin_width_;
+    size_t n_bins_;
+    double origin_;                      // Time at which the rate profile starts
+
+    std::vector<uint64_t> counters_;     // Per-source draw counters for the RNG
+    std::vector<double> pending_times_;
+};
@@ -6,7 +6,9 @@
 class SpikeMonitor {
 public:
     void on_spike(double time, size_t neuron_id);
+    // Keeps the capacity - later runs with as many spikes do not allocate
     void reset_spikes();
+    void reserve(size_t n_spikes);
 
     // Public for direct access from python
     // Pair: (time, neuron_id)
@@ -5,8 +5,11 @@
 class StateMonitor {
 public:
     StateMonitor(double reading_interval) : reading_interval_(reading_interval) {}
-    void on_read(double time, std::vector<double> state_vector);
+    void on_read(double time, const std::vector<double>& state_vector);
+    // Keeps the recorded vectors for reuse - later reads of the same size do not allocate
     void reset_recording();
+    // Pre-allocates storage for n_reads readings of n_states values
+    void reserve(size_t n_reads, size_t n_states);
     double get_reading_interval();
 
     // Public for direct access from python
@@ -14,4 +17,7 @@ public:
     std::vector<std::pair<double, std::vector<double>>> state_vector_list;
 
     double reading_interval_;
+
+private:
+    std::vector<std::vector<double>> spare_vectors_;
 };
\ No newline at end of file
@@ -0,0 +1,51 @@
+#pragma once
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "Synapse.h"
+
+// Index type of the forward CSR arrays (row_ptr, dst). The float build narrows it to 32 bits, so a delivered
+// synapse reads 8 bytes (target + weight) instead of 16 - it is then limited to 2^32 - 1 synapses and neurons.
+template <class Weight>
+using SynapseIndex = std::conditional_t<std::is_same_v<Weight, float>, uint32_t, size_t>;
+
+// Compressed sparse row (CSR) synapse storage: the outgoing synapses of neuron i are
+// [row_ptr[i], row_ptr[i+1]) in the SoA arrays, sorted by delay (insertion order among equal delays).
+// Consecutive synapses of a row with the same delay form a delay group, delivered as one spike packet:
+// the groups of row i are [row_group[i], row_group[i+1]), group g spans [group_ptr[g], group_ptr[g+1]).
+// The reverse index lists, for each post-synaptic neuron, the ids of its incoming synapses.
+// Weights are stored as Weight (float or double - see BasicNeuralNetwork) and targets as SynapseIndex<Weight>;
+// delays are times and stay double.
+template <class Weight>
+class BasicSynapseMatrix {
+public:
+    using Index = SynapseIndex<Weight>;
+
+    // Appends staged synapses (one vector per source neuron) and clears the staging rows.
+    // Throws std::length_error if the synapses or neurons do not fit in Index
+    void append(std::vector<std::vector<Synapse>>& staged);
+    // Recomputes the delay groups - needed after delays are modified in place
+    void build_delay_groups();
+    // Post -> synapse index used by plasticity rules
+    void build_reverse_index();
+
+    size_t size() const { return dst.size(); }
+    size_t num_rows() const { return row_ptr.empty() ? 0 : row_ptr.size() - 1; }
+    size_t num_groups() const { return group_ptr.empty() ? 0 : group_ptr.size() - 1; }
+    bool has_reverse_index() const { return !in_ptr.empty(); }
+
+    std::vector<Index> row_ptr;
+    std::vector<Index> dst;
+    std::vector<Weight> weight;
+    std::vector<double> delay;
+
+    std::vector<size_t> row_group;
+    std::vector<size_t> group_ptr;
+
+    std::vector<size_t> in_ptr;
+    std::vector<size_t> in_syn;
+    std::vector<size_t> src;   // Source of each synapse, only kept with the reverse index
+};
+
+using SynapseMatrix = BasicSynapseMatrix<double>;
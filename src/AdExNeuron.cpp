@@ -0,0 +1,101 @@
+#include "AdExNeuron.h"
+#include <cmath>
+#include <algorithm>
+#include <limits>
+#include <omp.h>
+
+AdExNeuron::AdExNeuron(double C_m, double g_L, double E_L, double v_T, double delta_T, double a,
+                       double tau_w, double b, double v_reset, double v_peak, double dt_int)
+    : C_m_(C_m),
+      g_L_(g_L),
+      E_L_(E_L),
+      v_T_(v_T),
+      delta_T_(delta_T),
+      a_(a),
+      tau_w_(tau_w),
+      b_(b),
+      v_reset_(v_reset),
+      v_peak_(v_peak),
+      dt_int_(dt_int) {}
+
+size_t AdExNeuron::get_num_state_vars() {
+    return 2;
+}
+
+double AdExNeuron::get_init_state(size_t var) {
+    return var == 0 ? E_L_ : 0.0;
+}
+
+bool AdExNeuron::receive_vars(double t, double charge, double* const* vars, double* last_spike, double* last_update) {
+    double v = vars[0][0] + charge / C_m_;
+    // A neuron held at the peak fires whatever the sign of the input
+    if (__builtin_expect(v >= v_peak_ || vars[0][0] >= v_peak_, 0)) {
+        vars[0][0] = v_reset_;
+        vars[1][0] += b_;
+        *last_spike = t;
+        return true;
+    }
+    vars[0][0] = v;
+    return false;
+}
+
+void AdExNeuron::step(double& v, double& w, double h) const {
+    // Exponent capped at the peak to avoid overflow on the step that crosses it
+    double exp_term = g_L_ * delta_T_ * std::exp((std::min(v, v_peak_) - v_T_) / delta_T_);
+    double dv = (-g_L_ * (v - E_L_) + exp_term - w) / C_m_;
+    double dw = (a_ * (v - E_L_) - w) / tau_w_;
+    v += h * dv;
+    w += h * dw;
+}
+
+void AdExNeuron::decay_vars(double t, double* const* vars, double* last_spike, double* last_update, size_t n) {
+    double* v = vars[0];
+    double* w = vars[1];
+
+    // The number of sub-steps differs per neuron, so neurons are only split across threads
+    #pragma omp parallel for schedule(static) if(omp_get_max_threads() > 1)
+    for (size_t i = 0; i < n; ++i) {
+        double dt = t - last_update[i];
+        if (dt <= 0.0) continue;
+        // Tolerance so that a whole number of steps (a predicted time) is not split into one more
+        size_t steps = std::max<size_t>(1, static_cast<size_t>(std::ceil(dt / dt_int_ - 1e-9)));
+        double h = dt / steps;
+        double vi = v[i], wi = w[i];
+        for (size_t s = 0; s < steps && vi < v_peak_; ++s) step(vi, wi, h);
+        v[i] = std::min(vi, v_peak_);
+        w[i] = wi;
+        last_update[i] = t;
+    }
+}
+
+bool AdExNeuron::predicts_spikes(double* const* vars, size_t n) {
+    return true;
+}
+
+double AdExNeuron::next_spike_time(double* const* vars, double* last_spike, double* last_update) {
+    double v = vars[0][0], w = vars[1][0];
+    if (v >= v_peak_) return *last_update;
+
+    // Settled: the state moves by less than a millionth of its scale over the horizon, so no crossing follows
+    const double horizon = PREDICTION_STEPS * dt_int_;
+    double dv = v, dw = w;
+    step(dv, dw, horizon);
+    const double v_scale = v_peak_ - E_L_;
+    if (std::abs(dv - v) < 1e-6 * v_scale && std::abs(dw - w) < 1e-6 * g_L_ * v_scale)
+        return std::numeric_limits<double>::infinity();
+
+    // Same steps as decay_vars over a whole number of steps
+    for (size_t s = 1; s <= PREDICTION_STEPS; ++s) {
+        step(v, w, dt_int_);
+        if (v >= v_peak_) return *last_update + s * dt_int_;
+    }
+    return *last_update + horizon;
+}
+
+bool AdExNeuron::fire_vars(double t, double* const* vars, double* last_spike, double* last_update) {
+    if (vars[0][0] < v_peak_) return false;
+    vars[0][0] = v_reset_;
+    vars[1][0] += b_;
+    *last_spike = t;
+    return true;
+}
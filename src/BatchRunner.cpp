@@ -0,0 +1,263 @@
+#include "BatchRunner.h"
+#include "LIFNeuron.h"
+#include "ExpCurrentLIFNeuron.h"
+#include "AdExNeuron.h"
+#include "IzhikevichNeuron.h"
+#include "InputNeuron.h"
+#include "SpikeMonitor.h"
+#include "SpikeCountMonitor.h"
+#include <algorithm>
+#include <exception>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <omp.h>
+
+static std::string line_error(size_t line, const std::string& message) {
+    return "line " + std::to_string(line) + ": " + message;
+}
+
+static double parse_double(const std::string& token, size_t line) {
+    size_t used = 0;
+    double value = 0.0;
+    try {
+        value = std::stod(token, &used);
+    } catch (const std::exception&) {
+        used = 0;
+    }
+    if (used == 0 || used != token.size()) throw std::invalid_argument(line_error(line, "invalid number '" + token + "'"));
+    return value;
+}
+
+static uint64_t parse_uint(const std::string& token, size_t line) {
+    size_t used = 0;
+    uint64_t value = 0;
+    try {
+        if (!token.empty() && token[0] != '-') value = std::stoull(token, &used);
+    } catch (const std::exception&) {
+        used = 0;
+    }
+    if (used == 0 || used != token.size()) throw std::invalid_argument(line_error(line, "invalid index '" + token + "'"));
+    return value;
+}
+
+// <value>, uniform:<low>:<high> or normal:<mean>:<std>
+static Distribution parse_distribution(const std::string& token, size_t line) {
+    std::vector<std::string> parts;
+    std::istringstream fields(token);
+    for (std::string part; std::getline(fields, part, ':');) parts.push_back(part);
+    if (parts.size() == 1) return Distribution(parse_double(parts[0], line));
+    if (parts.size() == 3 && parts[0] == "uniform")
+        return Distribution::uniform(parse_double(parts[1], line), parse_double(parts[2], line));
+    if (parts.size() == 3 && parts[0] == "normal")
+        return Distribution::normal(parse_double(parts[1], line), parse_double(parts[2], line));
+    throw std::invalid_argument(line_error(line, "invalid distribution '" + token + "'"));
+}
+
+// Statements split into tokens, without comments and blank lines - (line number, tokens)
+static std::vector<std::pair<size_t, std::vector<std::string>>> tokenize(std::istream& in) {
+    std::vector<std::pair<size_t, std::vector<std::string>>> statements;
+    size_t line_number = 0;
+    for (std::string line; std::getline(in, line);) {
+        ++line_number;
+        line = line.substr(0, line.find('#'));
+        std::istringstream fields(line);
+        std::vector<std::string> tokens;
+        for (std::string token; fields >> token;) tokens.push_back(token);
+        if (!tokens.empty()) statements.emplace_back(line_number, std::move(tokens));
+    }
+    return statements;
+}
+
+std::shared_ptr<Neuron> make_neuron_model(const std::string& model, const std::vector<double>& args) {
+    auto check = [&](size_t max_args) {
+        if (args.size() > max_args)
+            throw std::invalid_argument("Model " + model + " takes at most " + std::to_string(max_args) + " arguments");
+    };
+    // Constructor defaults for the arguments that are not given
+    auto arg = [&](size_t i, double fallback) { return i < args.size() ? args[i] : fallback; };
+
+    if (model == "lif") {
+        check(7);
+        return std::make_shared<LIFNeuron>(arg(0, 0.02), arg(1, 1e-6), arg(2, 0.07), arg(3, 0.07), arg(4, 0.05),
+                                           arg(5, 0.002), arg(6, 0.0));
+    }
+    if (model == "exp_lif") {
+        check(7);
+        return std::make_shared<ExpCurrentLIFNeuron>(arg(0, 0.02), arg(1, 0.005), arg(2, 1e-6), arg(3, 0.07),
+                                                     arg(4, 0.07), arg(5, 0.05), arg(6, 0.002));
+    }
+    if (model == "adex") {
+        check(11);
+        return std::make_shared<AdExNeuron>(arg(0, 281e-12), arg(1, 30e-9), arg(2, -70.6e-3), arg(3, -50.4e-3),
+                                            arg(4, 2e-3), arg(5, 4e-9), arg(6, 0.144), arg(7, 0.0805e-9),
+                                            arg(8, -70.6e-3), arg(9, 0.0), arg(10, 1e-4));
+    }
+    if (model == "izhikevich") {
+        check(5);
+        return std::make_shared<IzhikevichNeuron>(arg(0, 0.02), arg(1, 0.2), arg(2, -65.0), arg(3, 8.0), arg(4, 1e-4));
+    }
+    if (model == "input") {
+        check(0);
+        return std::make_shared<InputNeuron>();
+    }
+    throw std::invalid_argument("Unknown neuron model " + model);
+}
+
+NetworkSpec parse_network_spec(std::istream& in) {
+    NetworkSpec spec;
+    size_t n_neurons = 0;
+    for (const auto& [line, tokens] : tokenize(in)) {
+        const std::string& kind = tokens[0];
+        if (kind == "population") {
+            if (tokens.size() < 3) throw std::invalid_argument(line_error(line, "expected population <size> <model> [args...]"));
+            NetworkSpec::Population pop{parse_uint(tokens[1], line), tokens[2], {}};
+            for (size_t i = 3; i < tokens.size(); ++i) pop.args.push_back(parse_double(tokens[i], line));
+            try {
+                make_neuron_model(pop.model, pop.args);
+            } catch (const std::invalid_argument& e) {
+                throw std::invalid_argument(line_error(line, e.what()));
+            }
+            n_neurons += pop.size;
+            spec.populations.push_back(std::move(pop));
+        } else if (kind == "synapse") {
+            if (tokens.size() != 5) throw std::invalid_argument(line_error(line, "expected synapse <src> <dst> <weight> <delay>"));
+            size_t src = parse_uint(tokens[1], line), dst = parse_uint(tokens[2], line);
+            if (src >= n_neurons || dst >= n_neurons) throw std::invalid_argument(line_error(line, "neuron index out of bounds"));
+            spec.synapses.emplace_back(src, dst, parse_double(tokens[3], line), parse_double(tokens[4], line));
+        } else if (kind == "connect_random" || kind == "connect_fixed_outdegree" || kind == "connect_fixed_indegree") {
+            if (tokens.size() < 6 || tokens.size() > 8)
+                throw std::invalid_argument(line_error(line, "expected " + kind + " <pre_pop> <post_pop> <p|k> <weight> <delay> [seed] [allow_autapses]"));
+            NetworkSpec::Connection conn;
+            conn.rule = kind;
+            conn.pre_pop = parse_uint(tokens[1], line);
+            conn.post_pop = parse_uint(tokens[2], line);
+            if (conn.pre_pop >= spec.populations.size() || conn.post_pop >= spec.populations.size())
+                throw std::invalid_argument(line_error(line, "population index out of bounds"));
+            conn.p_or_k = kind == "connect_random" ? parse_double(tokens[3], line) : static_cast<double>(parse_uint(tokens[3], line));
+            conn.weight = parse_distribution(tokens[4], line);
+            conn.delay = parse_distribution(tokens[5], line);
+            conn.seed = tokens.size() > 6 ? parse_uint(tokens[6], line) : 0;
+            conn.allow_autapses = tokens.size() > 7 ? parse_uint(tokens[7], line) != 0 : true;
+            spec.connections.push_back(conn);
+        } else {
+            throw std::invalid_argument(line_error(line, "unknown statement '" + kind + "'"));
+        }
+    }
+    return spec;
+}
+
+NetworkSpec load_network_spec(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) throw std::runtime_error("Cannot open network file " + path);
+    return parse_network_spec(in);
+}
+
+std::vector<InputSample> parse_input_samples(std::istream& in) {
+    std::vector<InputSample> samples;
+    for (const auto& [line, tokens] : tokenize(in)) {
+        if (tokens.size() < 3 || tokens.size() > 4)
+            throw std::invalid_argument(line_error(line, "expected <sample> <time> <neuron> [weight]"));
+        size_t s = parse_uint(tokens[0], line);
+        if (s >= samples.size()) samples.resize(s + 1);
+        samples[s].times.push_back(parse_double(tokens[1], line));
+        samples[s].neurons.push_back(parse_uint(tokens[2], line));
+        samples[s].weights.push_back(tokens.size() > 3 ? parse_double(tokens[3], line) : 1.0);
+    }
+    return samples;
+}
+
+std::vector<InputSample> load_input_samples(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) throw std::runtime_error("Cannot open input file " + path);
+    return parse_input_samples(in);
+}
+
+void build_network(const NetworkSpec& spec, NeuralNetwork& net) {
+    for (const auto& pop : spec.populations)
+        net.add_neuron_population(pop.size, make_neuron_model(pop.model, pop.args));
+    for (const auto& syn : spec.synapses)
+        net.add_synapse(syn);
+    for (const auto& conn : spec.connections) {
+        size_t k = static_cast<size_t>(conn.p_or_k);
+        if (conn.rule == "connect_random")
+            net.connect_random(conn.pre_pop, conn.post_pop, conn.p_or_k, conn.weight, conn.delay, conn.seed, conn.allow_autapses);
+        else if (conn.rule == "connect_fixed_outdegree")
+            net.connect_fixed_outdegree(conn.pre_pop, conn.post_pop, k, conn.weight, conn.delay, conn.seed, conn.allow_autapses);
+        else
+            net.connect_fixed_indegree(conn.pre_pop, conn.post_pop, k, conn.weight, conn.delay, conn.seed, conn.allow_autapses);
+    }
+}
+
+BatchRunner::BatchRunner(NetworkSpec spec, double duration)
+    : spec_(std::move(spec)), duration_(duration), readout_first_(0), readout_size_(0), record_spikes_(false) {
+    if (!(duration >= 0.0)) throw std::invalid_argument("BatchRunner: duration must be non-negative");
+}
+
+void BatchRunner::set_readout(size_t first_neuron, size_t n_neurons) {
+    size_t n_total = 0;
+    for (const auto& pop : spec_.populations) n_total += pop.size;
+    if (first_neuron + n_neurons > n_total) throw std::out_of_range("Readout range out of bounds");
+    readout_first_ = first_neuron;
+    readout_size_ = n_neurons;
+}
+
+void BatchRunner::set_record_spikes(bool record) {
+    record_spikes_ = record;
+}
+
+struct BatchRunner::Worker {
+    Worker(const NetworkSpec& spec, bool record_spikes)
+        : counts(std::make_shared<SpikeCountMonitor>()),
+          spikes(record_spikes ? std::make_shared<SpikeMonitor>() : nullptr) {
+        build_network(spec, net);
+        net.set_spike_count_monitor(counts);
+        if (spikes) net.set_spike_monitor(spikes);
+    }
+
+    NeuralNetwork net;
+    std::shared_ptr<SpikeCountMonitor> counts;
+    std::shared_ptr<SpikeMonitor> spikes;
+};
+
+SampleResult BatchRunner::run_sample(Worker& worker, const InputSample& sample) const {
+    NeuralNetwork& net = worker.net;
+    net.reset();
+    net.schedule_spike_events(sample.times, sample.neurons, sample.weights);
+    net.run(duration_);
+
+    const size_t first = std::min(readout_first_, net.size());
+    const size_t end = readout_size_ > 0 ? first + readout_size_ : net.size();
+    SampleResult result;
+    result.counts.assign(worker.counts->counts.begin() + first, worker.counts->counts.begin() + end);
+    if (worker.spikes) {
+        for (const auto& spike : worker.spikes->spike_list)
+            if (spike.second >= first && spike.second < end) result.spikes.push_back(spike);
+    }
+    return result;
+}
+
+std::vector<SampleResult> BatchRunner::run(const std::vector<InputSample>& samples, size_t n_threads) const {
+    std::vector<SampleResult> results(samples.size());
+    // Networks set their own thread count on construction - the pool size is taken from the machine
+    const int threads = static_cast<int>(n_threads > 0 ? n_threads : static_cast<size_t>(omp_get_num_procs()));
+    std::exception_ptr error;
+
+    #pragma omp parallel num_threads(threads)
+    {
+        // Built on the first sample of the thread, then reset between samples
+        std::unique_ptr<Worker> worker;
+        #pragma omp for schedule(dynamic)
+        for (size_t s = 0; s < samples.size(); ++s) {
+            try {
+                if (!worker) worker = std::make_unique<Worker>(spec_, record_spikes_);
+                results[s] = run_sample(*worker, samples[s]);
+            } catch (...) {
+                #pragma omp critical
+                if (!error) error = std::current_exception();
+            }
+        }
+    }
+    if (error) std::rethrow_exception(error);
+    return results;
+}
@@ -0,0 +1,8 @@
+#include "BatchedNeuron.h"
+
+bool BatchedNeuron::receive(double t, double charge, double* state, double* last_spike, double* last_update) {
+    const size_t target = 0;
+    uint8_t fired = 0;
+    process_batch(1, &target, &t, &charge, state, last_spike, last_update, 1, &fired);
+    return fired != 0;
+}
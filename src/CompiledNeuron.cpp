@@ -0,0 +1,229 @@
+#include "CompiledNeuron.h"
+#include <cctype>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#ifndef _WIN32
+#include <dlfcn.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+CompiledNeuron::CompiledNeuron(ModelDefinition definition, std::shared_ptr<void> library, DecayFn decay_fn, ReceiveFn receive_fn,
+                               std::string library_path)
+    : definition_(std::move(definition)),
+      library_path_(std::move(library_path)),
+      library_(std::move(library)),
+      decay_fn_(decay_fn),
+      receive_fn_(receive_fn) {}
+
+void CompiledNeuron::decay(double t, double* state, double* last_spike, double* last_update, size_t n) {
+    if (definition_.state_vars.size() != 1) throw std::logic_error("CompiledNeuron: multi-state models use decay_vars");
+    double* vars[1] = {state};
+    decay_fn_(t, vars, last_spike, last_update, n);
+}
+
+bool CompiledNeuron::receive(double t, double charge, double* state, double* last_spike, double* last_update) {
+    if (definition_.state_vars.size() != 1) throw std::logic_error("CompiledNeuron: multi-state models use receive_vars");
+    double* vars[1] = {state};
+    return receive_fn_(t, charge, vars, last_spike, last_update);
+}
+
+double CompiledNeuron::get_init_value() {
+    return definition_.init_values[0];
+}
+
+size_t CompiledNeuron::get_num_state_vars() {
+    return definition_.state_vars.size();
+}
+
+double CompiledNeuron::get_init_state(size_t var) {
+    return definition_.init_values[var];
+}
+
+void CompiledNeuron::decay_vars(double t, double* const* vars, double* last_spike, double* last_update, size_t n) {
+    decay_fn_(t, vars, last_spike, last_update, n);
+}
+
+bool CompiledNeuron::receive_vars(double t, double charge, double* const* vars, double* last_spike, double* last_update) {
+    return receive_fn_(t, charge, vars, last_spike, last_update);
+}
+
+static void check_identifier(const std::string& name, std::set<std::string>& used) {
+    static const std::set<std::string> reserved = {
+        "t", "dt", "charge", "i", "n", "vars", "last_spike", "last_update", "refractory", "active", "fired"};
+    bool valid = !name.empty() && (std::isalpha(static_cast<unsigned char>(name[0])) || name[0] == '_');
+    for (char c : name) valid = valid && (std::isalnum(static_cast<unsigned char>(c)) || c == '_');
+    if (!valid) throw std::invalid_argument("ModelDefinition: invalid name '" + name + "'");
+    if (reserved.count(name)) throw std::invalid_argument("ModelDefinition: '" + name + "' is reserved");
+    if (!used.insert(name).second) throw std::invalid_argument("ModelDefinition: '" + name + "' is defined twice");
+}
+
+std::string generate_model_source(const ModelDefinition& def) {
+    if (def.state_vars.empty()) throw std::invalid_argument("ModelDefinition: at least one state variable is required");
+    if (def.init_values.size() != def.state_vars.size())
+        throw std::invalid_argument("ModelDefinition: one initial value per state variable is required");
+    if (def.threshold.empty()) throw std::invalid_argument("ModelDefinition: threshold condition is required");
+    std::set<std::string> used;
+    for (const auto& name : def.state_vars) check_identifier(name, used);
+    for (const auto& param : def.params) check_identifier(param.first, used);
+
+    const size_t K = def.state_vars.size();
+    std::ostringstream src;
+    src << std::setprecision(17);
+    src << "// Generated by snnblaze - do not edit\n"
+        << "#include <cmath>\n#include <cstddef>\n#include <algorithm>\n"
+        << "using namespace std;\n\n"
+        << "namespace {\n"
+        << "constexpr double refractory = " << def.refractory << ";\n";
+    for (const auto& param : def.params)
+        src << "constexpr double " << param.first << " = " << param.second << ";\n";
+    src << "}\n\n";
+
+    // Decay kernel over n neurons - refractory neurons keep their state and last update
+    src << "extern \"C\" void snnblaze_decay(double t, double* const* vars, double* last_spike, double* last_update, size_t n) {\n";
+    for (size_t k = 0; k < K; ++k)
+        src << "    double* __restrict state_" << k << "_ = vars[" << k << "];\n";
+    src << "    #pragma omp simd\n"
+        << "    for (size_t i = 0; i < n; ++i) {\n"
+        << "        const bool active = (t - last_spike[i]) >= refractory;\n"
+        << "        const double dt = t - last_update[i];\n";
+    for (size_t k = 0; k < K; ++k)
+        src << "        double " << def.state_vars[k] << " = state_" << k << "_[i];\n";
+    src << "        {\n" << def.decay << "\n        }\n";
+    for (size_t k = 0; k < K; ++k)
+        src << "        state_" << k << "_[i] = active ? " << def.state_vars[k] << " : state_" << k << "_[i];\n";
+    src << "        last_update[i] = active ? t : last_update[i];\n"
+        << "    }\n}\n\n";
+
+    // Input to one neuron
+    src << "extern \"C\" bool snnblaze_receive(double t, double charge, double* const* vars, double* last_spike, double* last_update) {\n"
+        << "    if ((t - *last_spike) < refractory) return false;\n";
+    for (size_t k = 0; k < K; ++k)
+        src << "    double " << def.state_vars[k] << " = *vars[" << k << "];\n";
+    src << "    {\n" << def.input << "\n    }\n"
+        << "    const bool fired = (" << def.threshold << ");\n"
+        << "    if (fired) {\n" << def.reset << "\n        *last_spike = t;\n    }\n";
+    for (size_t k = 0; k < K; ++k)
+        src << "    *vars[" << k << "] = " << def.state_vars[k] << ";\n";
+    src << "    return fired;\n}\n";
+    return src.str();
+}
+
+// FNV-1a - stable across builds and platforms, unlike std::hash
+static uint64_t fnv1a(const std::string& s) {
+    uint64_t h = 0xcbf29ce484222325ULL;
+    for (unsigned char c : s) {
+        h ^= c;
+        h *= 0x100000001b3ULL;
+    }
+    return h;
+}
+
+static std::string env_or(const char* name, const std::string& fallback) {
+    const char* value = std::getenv(name);
+    return value && *value ? value : fallback;
+}
+
+#ifndef _WIN32
+// Predefined macros of the compiler for the host CPU. They name the instruction set the kernels are built for,
+// so a cache shared between machines never loads a build for another CPU. Empty if -march=native is unsupported.
+static std::string native_target(const std::string& compiler) {
+    static std::mutex mutex;
+    static std::map<std::string, std::string> targets;
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = targets.find(compiler);
+    if (it != targets.end()) return it->second;
+
+    std::string macros;
+    if (FILE* pipe = popen((compiler + " -march=native -dM -E -x c++ /dev/null 2>/dev/null").c_str(), "r")) {
+        char buffer[4096];
+        for (size_t n; (n = std::fread(buffer, 1, sizeof(buffer), pipe)) > 0;) macros.append(buffer, n);
+        if (pclose(pipe) != 0) macros.clear();
+    }
+    return targets[compiler] = macros;
+}
+
+// $SNNBLAZE_CACHE_DIR, else the per-user cache directory ($XDG_CACHE_HOME or ~/.cache)
+static fs::path default_cache_dir() {
+    const std::string dir = env_or("SNNBLAZE_CACHE_DIR", "");
+    if (!dir.empty()) return dir;
+    const std::string xdg = env_or("XDG_CACHE_HOME", "");
+    if (!xdg.empty()) return fs::path(xdg) / "snnblaze_models";
+    const std::string home = env_or("HOME", "");
+    if (!home.empty()) return fs::path(home) / ".cache" / "snnblaze_models";
+    return fs::temp_directory_path() / ("snnblaze_models_" + std::to_string(geteuid()));
+}
+
+// Libraries are loaded into the process - refuses cache entries another user could have written
+static void check_private(const fs::path& path, bool directory) {
+    struct stat st;
+    if (lstat(path.c_str(), &st) != 0) throw std::runtime_error("compile_model: cannot access " + path.string());
+    bool valid = directory ? S_ISDIR(st.st_mode) : S_ISREG(st.st_mode);
+    if (!valid || st.st_uid != geteuid() || (st.st_mode & (S_IWGRP | S_IWOTH)))
+        throw std::runtime_error("compile_model: " + path.string() + " must be owned by the current user and not writable by others");
+}
+#endif
+
+std::shared_ptr<CompiledNeuron> compile_model(const ModelDefinition& definition, const std::string& cache_dir) {
+#ifdef _WIN32
+    throw std::runtime_error("compile_model: runtime compilation is not supported on Windows");
+#else
+    const std::string source = generate_model_source(definition);
+    const std::string compiler = env_or("SNNBLAZE_CXX", env_or("CXX", "c++"));
+    // No -ffast-math: last_spike starts at -inf, which finite-math kernels may not handle, and results should match the built-in models
+    const std::string target = native_target(compiler);
+    const std::string flags = std::string("-std=c++17 -O3 -fopenmp-simd -fPIC -shared") + (target.empty() ? "" : " -march=native");
+
+    std::ostringstream hash;
+    hash << std::hex << std::setw(16) << std::setfill('0') << fnv1a(compiler + '\n' + flags + '\n' + target + '\n' + source);
+    const fs::path dir = cache_dir.empty() ? default_cache_dir() : fs::path(cache_dir);
+    if (dir.has_parent_path()) fs::create_directories(dir.parent_path());
+    if (mkdir(dir.c_str(), 0700) != 0 && errno != EEXIST)
+        throw std::runtime_error("compile_model: cannot create " + dir.string());
+    check_private(dir, true);
+    const fs::path library = dir / ("model_" + hash.str() + ".so");
+
+    if (!fs::exists(library)) {
+        // Built under a unique name then renamed, so concurrent processes never load a partial file
+        const std::string stem = "model_" + hash.str() + "." + std::to_string(getpid());
+        const fs::path src_path = dir / (stem + ".cpp");
+        const fs::path tmp_path = dir / (stem + ".so");
+        const fs::path log_path = dir / (stem + ".log");
+        std::ofstream(src_path) << source;
+
+        std::string command = compiler + " " + flags + " -o \"" + tmp_path.string() + "\" \"" + src_path.string() +
+                              "\" > \"" + log_path.string() + "\" 2>&1";
+        if (std::system(command.c_str()) != 0) {
+            std::ifstream log(log_path);
+            std::string output((std::istreambuf_iterator<char>(log)), std::istreambuf_iterator<char>());
+            throw std::runtime_error("compile_model: compilation failed (" + src_path.string() + ")\n" + output);
+        }
+        fs::rename(tmp_path, library);
+        fs::remove(log_path);
+        fs::rename(src_path, dir / ("model_" + hash.str() + ".cpp"));
+    }
+
+    check_private(library, false);
+    void* handle = dlopen(library.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (!handle) throw std::runtime_error(std::string("compile_model: ") + dlerror());
+    std::shared_ptr<void> lib(handle, [](void* h) { dlclose(h); });
+
+    auto decay_fn = reinterpret_cast<CompiledNeuron::DecayFn>(dlsym(handle, "snnblaze_decay"));
+    auto receive_fn = reinterpret_cast<CompiledNeuron::ReceiveFn>(dlsym(handle, "snnblaze_receive"));
+    if (!decay_fn || !receive_fn) throw std::runtime_error("compile_model: kernels missing from " + library.string());
+    return std::make_shared<CompiledNeuron>(definition, std::move(lib), decay_fn, receive_fn, library.string());
+#endif
+}
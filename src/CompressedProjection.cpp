@@ -0,0 +1,150 @@
+#include "CompressedProjection.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+CompressedProjection::CompressedProjection(size_t pre_begin, size_t n_pre, size_t post_begin, size_t n_post,
+                                           WeightBits bits, double weight_scale)
+    : Projection(pre_begin, n_pre, post_begin, n_post),
+      bits_(bits),
+      weight_scale_(weight_scale),
+      row_group_(n_pre + 1, 0),
+      group_ptr_(1, 0),
+      group_byte_(1, 0),
+      row_scales_(n_pre, static_cast<float>(weight_scale)) {
+    if (weight_scale < 0.0) throw std::invalid_argument("CompressedProjection: weight scale must be non-negative");
+}
+
+void CompressedProjection::compress(std::vector<std::vector<Synapse>>& rows) {
+    if (num_synapses() > 0) throw std::invalid_argument("CompressedProjection: synapses were already compressed");
+    if (rows.size() < pre_begin_ + n_pre_) throw std::out_of_range("CompressedProjection: missing source rows");
+    const double q_max = bits_ == WeightBits::Int8 ? std::numeric_limits<int8_t>::max() : std::numeric_limits<int16_t>::max();
+
+    for (size_t i = 0; i < n_pre_; ++i) {
+        auto& row = rows[pre_begin_ + i];
+        for (const auto& syn : row) {
+            if (syn.dst_id - post_begin_ >= n_post_) throw std::out_of_range("CompressedProjection: target outside the projection");
+            if (syn.delay < 0.0) throw std::invalid_argument("CompressedProjection: delays must be non-negative");
+        }
+        std::sort(row.begin(), row.end(), [](const Synapse& a, const Synapse& b) {
+            return a.delay < b.delay || (a.delay == b.delay && a.dst_id < b.dst_id);
+        });
+
+        double scale = weight_scale_;
+        if (scale == 0.0) {
+            double w_max = 0.0;
+            for (const auto& syn : row) w_max = std::max(w_max, std::abs(syn.weight));
+            scale = w_max > 0.0 ? w_max / q_max : 1.0;
+            row_scales_[i] = static_cast<float>(scale);
+        }
+        // Quantize against the stored (float) step so decoding reproduces the nearest level
+        const double step = row_scales_[i];
+
+        const uint64_t row_start = group_ptr_.back();
+        size_t prev = post_begin_;
+        for (size_t k = 0; k < row.size(); ++k) {
+            const Synapse& syn = row[k];
+            if (k == 0 || syn.delay != row[k - 1].delay) {
+                // New delay group - the gaps restart from post_begin
+                auto it = std::find(delay_table_.begin(), delay_table_.end(), syn.delay);
+                if (it == delay_table_.end()) {
+                    if (delay_table_.size() == 256) throw std::invalid_argument("CompressedProjection: at most 256 distinct delays");
+                    delay_table_.push_back(syn.delay);
+                    it = delay_table_.end() - 1;
+                }
+                if (k > 0) {
+                    group_ptr_.push_back(row_start + k);
+                    group_byte_.push_back(target_bytes_.size());
+                }
+                group_delay_.push_back(static_cast<uint8_t>(it - delay_table_.begin()));
+                prev = post_begin_;
+            }
+
+            // LEB128: 7 bits per byte, high bit set on all but the last byte
+            uint64_t gap = syn.dst_id - prev;
+            prev = syn.dst_id;
+            do {
+                uint8_t byte = gap & 0x7f;
+                gap >>= 7;
+                target_bytes_.push_back(gap ? byte | 0x80 : byte);
+            } while (gap);
+
+            double q = std::clamp(std::round(syn.weight / step), -q_max, q_max);
+            if (bits_ == WeightBits::Int8) weights8_.push_back(static_cast<int8_t>(q));
+            else weights16_.push_back(static_cast<int16_t>(q));
+        }
+        if (!row.empty()) {
+            group_ptr_.push_back(row_start + row.size());
+            group_byte_.push_back(target_bytes_.size());
+        }
+        row_group_[i + 1] = group_delay_.size();
+        row.clear();
+        row.shrink_to_fit();
+    }
+    target_bytes_.shrink_to_fit();
+    weights8_.shrink_to_fit();
+    weights16_.shrink_to_fit();
+}
+
+template <class Q>
+void CompressedProjection::decode(size_t row, size_t group, const std::vector<Q>& weights, std::vector<Synapse>& out) const {
+    const size_t begin = group_ptr_[group], n = group_ptr_[group + 1] - begin;
+    const size_t first = out.size();
+    out.resize(first + n, Synapse(0, 0));
+    Synapse* syn = out.data() + first;
+
+    // Targets: sequential prefix sum over the varint gaps
+    const uint8_t* bytes = target_bytes_.data() + group_byte_[group];
+    size_t dst = post_begin_;
+    for (size_t k = 0; k < n; ++k) {
+        uint64_t gap = 0;
+        unsigned shift = 0;
+        uint8_t byte;
+        do {
+            byte = *bytes++;
+            gap |= static_cast<uint64_t>(byte & 0x7f) << shift;
+            shift += 7;
+        } while (byte & 0x80);
+        dst += gap;
+        syn[k].dst_id = dst;
+    }
+
+    // Weights and the shared source/delay: independent per synapse
+    const size_t src = pre_begin_ + row;
+    const float scale = row_scales_[row];
+    const double delay = delay_table_[group_delay_[group]];
+    const Q* q = weights.data() + begin;
+    for (size_t k = 0; k < n; ++k) {
+        syn[k].src_id = src;
+        syn[k].weight = scale * q[k];
+        syn[k].delay = delay;
+    }
+}
+
+void CompressedProjection::generate_group(size_t neuron_id, size_t group, std::vector<Synapse>& out) const {
+    size_t row = neuron_id - pre_begin_;
+    size_t g = row_group_[row] + group;
+    if (bits_ == WeightBits::Int8) decode(row, g, weights8_, out);
+    else decode(row, g, weights16_, out);
+}
+
+void CompressedProjection::generate(size_t neuron_id, std::vector<Synapse>& out) const {
+    for (size_t g = 0; g < num_groups(neuron_id); ++g) generate_group(neuron_id, g, out);
+}
+
+void CompressedProjection::scale_weights(double factor) {
+    weight_scale_ *= factor;
+    for (auto& scale : row_scales_) scale = static_cast<float>(scale * factor);
+}
+
+double CompressedProjection::min_delay() const {
+    if (delay_table_.empty()) return std::numeric_limits<double>::infinity();
+    return *std::min_element(delay_table_.begin(), delay_table_.end());
+}
+
+size_t CompressedProjection::memory_bytes() const {
+    return target_bytes_.size() + weights8_.size() + 2 * weights16_.size()
+         + (row_group_.size() + group_ptr_.size() + group_byte_.size()) * sizeof(uint64_t) + group_delay_.size()
+         + row_scales_.size() * sizeof(float) + delay_table_.size() * sizeof(double);
+}
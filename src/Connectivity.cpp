@@ -0,0 +1,237 @@
+#include "Connectivity.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <omp.h>
+
+// Counter ranges of a stream: structure draws from 0, weights from WEIGHT_DRAWS, delays from DELAY_DRAWS
+static constexpr uint64_t WEIGHT_DRAWS = 1ULL << 40;
+static constexpr uint64_t DELAY_DRAWS = 2ULL << 40;
+static constexpr uint64_t MIRROR = 1ULL << 63;
+static constexpr double PI = 3.14159265358979323846;
+
+double Distribution::sample(const CounterRNG& rng, uint64_t stream, uint64_t counter) const {
+    switch (kind) {
+    case Kind::Uniform:
+        return a + (b - a) * rng.uniform(stream, counter);
+    case Kind::Normal: {
+        // Box-Muller
+        double u1 = rng.uniform(stream, counter);
+        double u2 = rng.uniform(stream, counter | MIRROR);
+        return a + b * std::sqrt(-2.0 * std::log(u1)) * std::cos(2.0 * PI * u2);
+    }
+    default:
+        return a;
+    }
+}
+
+static inline void emit(std::vector<Synapse>& row, size_t src, size_t dst, size_t n,
+                        const CounterRNG& rng, uint64_t stream,
+                        const Distribution& weight, const Distribution& delay) {
+    double w = weight.sample(rng, stream, WEIGHT_DRAWS + n);
+    double d = std::max(0.0, delay.sample(rng, stream, DELAY_DRAWS + n));
+    row.emplace_back(src, dst, w, d);
+}
+
+// Index of the neuron itself within [begin, begin + n), or n if it is outside
+static inline size_t self_offset(size_t id, size_t begin, size_t n) {
+    return id - begin < n ? id - begin : n;
+}
+
+static inline bool ranges_overlap(size_t a_begin, size_t a_n, size_t b_begin, size_t b_n) {
+    return a_n > 0 && b_n > 0 && a_begin < b_begin + b_n && b_begin < a_begin + a_n;
+}
+
+// Draws k distinct values of [0, m) - partial Fisher-Yates on perm (identity on entry and on return)
+static void sample_distinct(const CounterRNG& rng, uint64_t stream, size_t k, size_t m,
+                            std::vector<size_t>& perm, std::vector<size_t>& swaps, std::vector<size_t>& out) {
+    if (perm.size() < m) {
+        size_t old = perm.size();
+        perm.resize(m);
+        for (size_t i = old; i < m; ++i) perm[i] = i;
+    }
+    swaps.resize(k);
+    out.resize(k);
+    for (size_t r = 0; r < k; ++r) {
+        size_t j = r + std::min(static_cast<size_t>(rng.uniform(stream, r) * (m - r)), m - r - 1);
+        std::swap(perm[r], perm[j]);
+        swaps[r] = j;
+        out[r] = perm[r];
+    }
+    for (size_t r = k; r-- > 0;) std::swap(perm[r], perm[swaps[r]]);
+    std::sort(out.begin(), out.end());
+}
+
+size_t connect_random(std::vector<std::vector<Synapse>>& rows,
+                      size_t pre_begin, size_t n_pre, size_t post_begin, size_t n_post,
+                      double p, const Distribution& weight, const Distribution& delay,
+                      uint64_t seed, bool allow_autapses) {
+    if (p < 0.0 || p > 1.0) throw std::invalid_argument("connect_random: p must be in [0, 1]");
+    if (p == 0.0 || n_post == 0) return 0;
+    const CounterRNG rng(seed);
+    const double inv_log_q = p < 1.0 ? 1.0 / std::log1p(-p) : 0.0;
+    size_t count = 0;
+
+    #pragma omp parallel for schedule(dynamic, 64) reduction(+:count) if(omp_get_max_threads() > 1)
+    for (size_t i = 0; i < n_pre; ++i) {
+        const size_t src = pre_begin + i;
+        const size_t self = allow_autapses ? n_post : self_offset(src, post_begin, n_post);
+        auto& row = rows[src];
+        size_t n = 0;
+        // Geometric skipping: gaps between consecutive targets are geometrically distributed
+        double j = -1.0;
+        for (uint64_t c = 0;; ++c) {
+            j += p < 1.0 ? 1.0 + std::floor(std::log(rng.uniform(src, c)) * inv_log_q) : 1.0;
+            if (j >= static_cast<double>(n_post)) break;
+            size_t t = static_cast<size_t>(j);
+            if (t != self) emit(row, src, post_begin + t, n++, rng, src, weight, delay);
+        }
+        count += n;
+    }
+    return count;
+}
+
+size_t connect_fixed_outdegree(std::vector<std::vector<Synapse>>& rows,
+                               size_t pre_begin, size_t n_pre, size_t post_begin, size_t n_post,
+                               size_t k, const Distribution& weight, const Distribution& delay,
+                               uint64_t seed, bool allow_autapses) {
+    const CounterRNG rng(seed);
+    // Without autapses a source inside the target range has one target fewer
+    const size_t excluded = !allow_autapses && ranges_overlap(pre_begin, n_pre, post_begin, n_post);
+    if (k + excluded > n_post)
+        throw std::invalid_argument("connect_fixed_outdegree: k exceeds the number of targets");
+
+    #pragma omp parallel if(omp_get_max_threads() > 1)
+    {
+        std::vector<size_t> perm, swaps, chosen;
+        #pragma omp for schedule(dynamic, 64)
+        for (size_t i = 0; i < n_pre; ++i) {
+            const size_t src = pre_begin + i;
+            const size_t self = allow_autapses ? n_post : self_offset(src, post_begin, n_post);
+            sample_distinct(rng, src, k, self < n_post ? n_post - 1 : n_post, perm, swaps, chosen);
+            auto& row = rows[src];
+            for (size_t r = 0; r < k; ++r) {
+                size_t t = chosen[r] + (chosen[r] >= self);
+                emit(row, src, post_begin + t, r, rng, src, weight, delay);
+            }
+        }
+    }
+    return n_pre * k;
+}
+
+size_t connect_fixed_indegree(std::vector<std::vector<Synapse>>& rows,
+                              size_t pre_begin, size_t n_pre, size_t post_begin, size_t n_post,
+                              size_t k, const Distribution& weight, const Distribution& delay,
+                              uint64_t seed, bool allow_autapses) {
+    const CounterRNG rng(seed);
+    const size_t excluded = !allow_autapses && ranges_overlap(pre_begin, n_pre, post_begin, n_post);
+    if (k + excluded > n_pre)
+        throw std::invalid_argument("connect_fixed_indegree: k exceeds the number of sources");
+
+    // Sources are drawn per target in parallel, then scattered into the source rows in target order
+    std::vector<size_t> sources(n_post * k);
+    #pragma omp parallel if(omp_get_max_threads() > 1)
+    {
+        std::vector<size_t> perm, swaps, chosen;
+        #pragma omp for schedule(dynamic, 64)
+        for (size_t j = 0; j < n_post; ++j) {
+            const size_t dst = post_begin + j;
+            const size_t self = allow_autapses ? n_pre : self_offset(dst, pre_begin, n_pre);
+            sample_distinct(rng, dst, k, self < n_pre ? n_pre - 1 : n_pre, perm, swaps, chosen);
+            for (size_t r = 0; r < k; ++r)
+                sources[j * k + r] = pre_begin + chosen[r] + (chosen[r] >= self);
+        }
+    }
+    for (size_t j = 0; j < n_post; ++j)
+        for (size_t r = 0; r < k; ++r)
+            emit(rows[sources[j * k + r]], sources[j * k + r], post_begin + j, r, rng, post_begin + j, weight, delay);
+    return n_post * k;
+}
+
+size_t connect_distance(std::vector<std::vector<Synapse>>& rows,
+                        size_t pre_begin, const std::vector<double>& pre_positions,
+                        size_t post_begin, const std::vector<double>& post_positions,
+                        double C, double lambda, const Distribution& weight, const Distribution& delay,
+                        uint64_t seed, bool allow_autapses) {
+    if (pre_positions.size() % 3 != 0 || post_positions.size() % 3 != 0)
+        throw std::invalid_argument("connect_distance: positions must be (x, y, z) triplets");
+    if (lambda <= 0.0) throw std::invalid_argument("connect_distance: lambda must be positive");
+    const size_t n_pre = pre_positions.size() / 3;
+    const size_t n_post = post_positions.size() / 3;
+    const CounterRNG rng(seed);
+    const double inv_lambda2 = 1.0 / (lambda * lambda);
+    size_t count = 0;
+
+    #pragma omp parallel for schedule(dynamic, 16) reduction(+:count) if(omp_get_max_threads() > 1)
+    for (size_t i = 0; i < n_pre; ++i) {
+        const size_t src = pre_begin + i;
+        const double* a = &pre_positions[3 * i];
+        auto& row = rows[src];
+        size_t n = 0;
+        for (size_t j = 0; j < n_post; ++j) {
+            if (!allow_autapses && post_begin + j == src) continue;
+            const double* b = &post_positions[3 * j];
+            double dx = a[0] - b[0], dy = a[1] - b[1], dz = a[2] - b[2];
+            double p = C * std::exp(-(dx * dx + dy * dy + dz * dz) * inv_lambda2);
+            if (rng.uniform(src, j) < p) emit(row, src, post_begin + j, n++, rng, src, weight, delay);
+        }
+        count += n;
+    }
+    return count;
+}
+
+size_t connect_small_world(std::vector<std::vector<Synapse>>& rows,
+                           size_t begin, size_t n, size_t k, double beta,
+                           const Distribution& weight, const Distribution& delay, uint64_t seed) {
+    if (k % 2 != 0 || k >= n) throw std::invalid_argument("connect_small_world: k must be even and smaller than n");
+    if (beta < 0.0 || beta > 1.0) throw std::invalid_argument("connect_small_world: beta must be in [0, 1]");
+    const CounterRNG rng(seed);
+
+    #pragma omp parallel if(omp_get_max_threads() > 1)
+    {
+        std::vector<size_t> targets(k);
+        std::vector<char> rewired(k);
+        #pragma omp for schedule(dynamic, 64)
+        for (size_t i = 0; i < n; ++i) {
+            const size_t src = begin + i;
+            for (size_t e = 0; e < k; ++e) {
+                // Neighbours i-k/2 .. i+k/2, skipping i
+                size_t offset = e < k / 2 ? n - k / 2 + e : e - k / 2 + 1;
+                targets[e] = (i + offset) % n;
+                rewired[e] = rng.uniform(src, 2 * e) < beta;
+            }
+            // Rewired to any neuron but itself that is not a target of the row yet, redrawn past the first 2k draws.
+            // The row has fewer than n - 1 other targets, so a free one always exists.
+            uint64_t counter = 2 * k;
+            for (size_t e = 0; e < k; ++e) {
+                if (!rewired[e]) continue;
+                size_t t;
+                for (uint64_t c = 2 * e + 1;; c = counter++) {
+                    size_t r = std::min(static_cast<size_t>(rng.uniform(src, c) * (n - 1)), n - 2);
+                    t = r + (r >= i);
+                    bool taken = false;
+                    for (size_t f = 0; f < k && !taken; ++f)
+                        taken = f != e && targets[f] == t && (!rewired[f] || f < e);
+                    if (!taken) break;
+                }
+                targets[e] = t;
+            }
+            auto& row = rows[src];
+            for (size_t e = 0; e < k; ++e) emit(row, src, begin + targets[e], e, rng, src, weight, delay);
+        }
+    }
+    return n * k;
+}
+
+std::vector<double> grid_positions(size_t nx, size_t ny, size_t nz, double spacing) {
+    std::vector<double> positions;
+    positions.reserve(3 * nx * ny * nz);
+    for (size_t z = 0; z < nz; ++z)
+        for (size_t y = 0; y < ny; ++y)
+            for (size_t x = 0; x < nx; ++x) {
+                positions.push_back(x * spacing);
+                positions.push_back(y * spacing);
+                positions.push_back(z * spacing);
+            }
+    return positions;
+}
@@ -0,0 +1,75 @@
+#include "ConvProjection.h"
+#include <stdexcept>
+#include <string>
+
+static size_t conv_out_size(size_t in, size_t kernel, size_t stride, size_t padding) {
+    if (kernel == 0 || stride == 0 || in + 2 * padding < kernel)
+        throw std::invalid_argument("ConvProjection: kernel does not fit the padded input");
+    return (in + 2 * padding - kernel) / stride + 1;
+}
+
+ConvProjection::ConvProjection(size_t pre_begin, size_t in_channels, size_t in_height, size_t in_width,
+                               size_t post_begin, size_t out_channels, size_t kernel_h, size_t kernel_w,
+                               const std::vector<double>& weights, double delay,
+                               size_t stride, size_t padding, bool depthwise)
+    : Projection(pre_begin, in_channels * in_height * in_width, post_begin, 0),
+      in_channels_(in_channels),
+      in_height_(in_height),
+      in_width_(in_width),
+      out_channels_(depthwise ? in_channels : out_channels),
+      kernel_h_(kernel_h),
+      kernel_w_(kernel_w),
+      stride_(stride),
+      padding_(padding),
+      depthwise_(depthwise),
+      weights_(weights),
+      delay_(delay),
+      out_height_(conv_out_size(in_height, kernel_h, stride, padding)),
+      out_width_(conv_out_size(in_width, kernel_w, stride, padding)) {
+    if (depthwise && out_channels != in_channels)
+        throw std::invalid_argument("ConvProjection: depthwise projections need out_channels == in_channels");
+    size_t expected = (depthwise ? 1 : out_channels_) * in_channels_ * kernel_h_ * kernel_w_;
+    if (weights_.size() != expected)
+        throw std::invalid_argument("ConvProjection: weights must have " + std::to_string(expected) + " entries");
+    n_post_ = out_channels_ * out_height_ * out_width_;
+}
+
+void ConvProjection::generate(size_t neuron_id, std::vector<Synapse>& out) const {
+    size_t local = neuron_id - pre_begin_;
+    size_t x = local % in_width_;
+    size_t y = (local / in_width_) % in_height_;
+    size_t c = local / (in_width_ * in_height_);
+    const size_t kernel_size = kernel_h_ * kernel_w_;
+
+    // Output (oy, ox) sees input (oy * stride + ky - padding, ox * stride + kx - padding)
+    for (size_t ky = 0; ky < kernel_h_; ++ky) {
+        size_t py = y + padding_;
+        if (py < ky || (py - ky) % stride_ != 0) continue;
+        size_t oy = (py - ky) / stride_;
+        if (oy >= out_height_) continue;
+
+        for (size_t kx = 0; kx < kernel_w_; ++kx) {
+            size_t px = x + padding_;
+            if (px < kx || (px - kx) % stride_ != 0) continue;
+            size_t ox = (px - kx) / stride_;
+            if (ox >= out_width_) continue;
+
+            size_t k = ky * kernel_w_ + kx;
+            if (depthwise_) {
+                double w = weights_[c * kernel_size + k];
+                if (w != 0.0)
+                    out.emplace_back(neuron_id, post_begin_ + (c * out_height_ + oy) * out_width_ + ox, w, delay_);
+                continue;
+            }
+            for (size_t co = 0; co < out_channels_; ++co) {
+                double w = weights_[(co * in_channels_ + c) * kernel_size + k];
+                if (w != 0.0)
+                    out.emplace_back(neuron_id, post_begin_ + (co * out_height_ + oy) * out_width_ + ox, w, delay_);
+            }
+        }
+    }
+}
+
+void ConvProjection::scale_weights(double factor) {
+    for (double& w : weights_) w *= factor;
+}
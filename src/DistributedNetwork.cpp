@@ -0,0 +1,208 @@
+#include "DistributedNetwork.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+DistributedNetwork::DistributedNetwork(MPI_Comm comm)
+    : comm_(comm),
+      global_size_(0),
+      local_min_delay_(std::numeric_limits<double>::infinity()),
+      outbox_(std::make_shared<SpikeMonitor>()) {
+    MPI_Comm_rank(comm_, &rank_);
+    MPI_Comm_size(comm_, &n_ranks_);
+    local_.set_export_monitor(outbox_);
+    send_buffers_.resize(n_ranks_);
+    send_counts_.resize(n_ranks_);
+    recv_counts_.resize(n_ranks_);
+    send_displs_.resize(n_ranks_);
+    recv_displs_.resize(n_ranks_);
+}
+
+void DistributedNetwork::add_neuron_population(size_t size, std::shared_ptr<Neuron> neuron_type) {
+    Partition p;
+    p.global_first = global_size_;
+    p.size = size;
+    p.local_population = -1;
+    p.local_first.resize(n_ranks_);
+    for (int r = 0; r < n_ranks_; ++r) {
+        // Neurons of the earlier populations owned by rank r
+        size_t first = 0;
+        for (const auto& q : partitions_) first += block_begin(q, r + 1) - block_begin(q, r);
+        p.local_first[r] = first;
+    }
+
+    size_t n_local = block_begin(p, rank_ + 1) - block_begin(p, rank_);
+    if (n_local > 0) {
+        size_t populations = 0;
+        for (const auto& q : partitions_) populations += q.local_population >= 0;
+        p.local_population = static_cast<int>(populations);
+        local_.add_neuron_population(n_local, std::move(neuron_type));
+    }
+    partitions_.push_back(std::move(p));
+    global_size_ += size;
+    remote_rows_.resize(local_.size());
+}
+
+const DistributedNetwork::Partition& DistributedNetwork::partition_of(size_t neuron_index) const {
+    if (neuron_index >= global_size_) throw std::out_of_range("Neuron index out of bounds");
+    auto it = std::upper_bound(partitions_.begin(), partitions_.end(), neuron_index,
+                               [](size_t id, const Partition& p) { return id < p.global_first; });
+    return *(it - 1);
+}
+
+int DistributedNetwork::owner(size_t neuron_index) const {
+    const Partition& p = partition_of(neuron_index);
+    size_t i = neuron_index - p.global_first;
+    // Inverse of block_begin: the first rank whose block ends after i
+    return static_cast<int>(((i + 1) * n_ranks_ - 1) / p.size);
+}
+
+bool DistributedNetwork::is_local(size_t neuron_index) const {
+    return owner(neuron_index) == rank_;
+}
+
+size_t DistributedNetwork::local_index_on(const Partition& p, size_t neuron_index, int rank) const {
+    return p.local_first[rank] + (neuron_index - p.global_first - block_begin(p, rank));
+}
+
+size_t DistributedNetwork::to_local(size_t neuron_index) const {
+    if (!is_local(neuron_index)) throw std::out_of_range("Neuron is owned by another rank");
+    return local_index_on(partition_of(neuron_index), neuron_index, rank_);
+}
+
+size_t DistributedNetwork::to_global(size_t local_index) const {
+    for (const auto& p : partitions_) {
+        size_t n_local = block_begin(p, rank_ + 1) - block_begin(p, rank_);
+        if (local_index - p.local_first[rank_] < n_local)
+            return p.global_first + block_begin(p, rank_) + (local_index - p.local_first[rank_]);
+    }
+    throw std::out_of_range("Local index out of bounds");
+}
+
+size_t DistributedNetwork::size() const {
+    return global_size_;
+}
+
+void DistributedNetwork::add_synapse(const Synapse& synapse) {
+    int src_rank = owner(synapse.src_id);
+    int dst_rank = owner(synapse.dst_id);
+    if (src_rank != rank_) return;
+
+    size_t src = to_local(synapse.src_id);
+    if (dst_rank == rank_) {
+        local_.add_synapse(Synapse(src, to_local(synapse.dst_id), synapse.weight, synapse.delay));
+        return;
+    }
+    size_t target = local_index_on(partition_of(synapse.dst_id), synapse.dst_id, dst_rank);
+    remote_rows_[src].push_back(RemoteSynapse{dst_rank, target, synapse.weight, synapse.delay});
+    local_min_delay_ = std::min(local_min_delay_, synapse.delay);
+}
+
+void DistributedNetwork::schedule_spike_event(double time, size_t neuron_index, double weight) {
+    if (is_local(neuron_index)) local_.schedule_spike_event(time, to_local(neuron_index), weight);
+}
+
+double DistributedNetwork::min_remote_delay() {
+    double min_delay = local_min_delay_;
+    MPI_Allreduce(&local_min_delay_, &min_delay, 1, MPI_DOUBLE, MPI_MIN, comm_);
+    return min_delay;
+}
+
+void DistributedNetwork::run(double T) {
+    // No remote spike emitted within an epoch can arrive before the epoch ends
+    const double epoch = min_remote_delay();
+    if (epoch <= 0.0) throw std::invalid_argument("DistributedNetwork: synapses between ranks need a positive delay");
+
+    const double start = local_.sim_time;
+    const double end = start + T;
+    const size_t n_epochs = epoch >= T ? 1 : static_cast<size_t>(std::ceil(T / epoch));
+    for (size_t k = 1; k <= n_epochs; ++k) {
+        // Absolute boundaries, so the epochs do not accumulate rounding errors
+        local_.run_until(k == n_epochs ? end : start + k * epoch);
+        exchange();
+    }
+}
+
+void DistributedNetwork::exchange() {
+    for (const auto& spike : outbox_->spike_list) {
+        spikes_.emplace_back(spike.first, to_global(spike.second));
+        for (const auto& syn : remote_rows_[spike.second])
+            send_buffers_[syn.rank].push_back(WireEvent{spike.first + syn.delay, syn.weight, syn.target});
+    }
+    outbox_->reset_spikes();
+
+    // Events are sent as raw bytes - all ranks run the same binary
+    int send_total = 0;
+    for (int r = 0; r < n_ranks_; ++r) {
+        send_counts_[r] = static_cast<int>(send_buffers_[r].size() * sizeof(WireEvent));
+        send_displs_[r] = send_total;
+        send_total += send_counts_[r];
+    }
+    MPI_Alltoall(send_counts_.data(), 1, MPI_INT, recv_counts_.data(), 1, MPI_INT, comm_);
+    int recv_total = 0;
+    for (int r = 0; r < n_ranks_; ++r) {
+        recv_displs_[r] = recv_total;
+        recv_total += recv_counts_[r];
+    }
+
+    send_flat_.clear();
+    for (auto& buffer : send_buffers_) {
+        send_flat_.insert(send_flat_.end(), buffer.begin(), buffer.end());
+        buffer.clear();
+    }
+    recv_flat_.resize(recv_total / sizeof(WireEvent));
+    MPI_Alltoallv(send_flat_.data(), send_counts_.data(), send_displs_.data(), MPI_BYTE,
+                  recv_flat_.data(), recv_counts_.data(), recv_displs_.data(), MPI_BYTE, comm_);
+
+    for (const auto& ev : recv_flat_)
+        local_.schedule_absolute_spike_event(ev.time, ev.target, ev.weight);
+}
+
+std::vector<std::pair<double, size_t>> DistributedNetwork::gather_spikes(int root) {
+    struct WireSpike {
+        double time;
+        uint64_t neuron;
+    };
+    std::vector<WireSpike> local(spikes_.size());
+    for (size_t i = 0; i < spikes_.size(); ++i) local[i] = WireSpike{spikes_[i].first, spikes_[i].second};
+
+    int count = static_cast<int>(local.size() * sizeof(WireSpike));
+    std::vector<int> counts(n_ranks_), displs(n_ranks_);
+    MPI_Gather(&count, 1, MPI_INT, counts.data(), 1, MPI_INT, root, comm_);
+    int total = 0;
+    for (int r = 0; r < n_ranks_; ++r) {
+        displs[r] = total;
+        total += counts[r];
+    }
+    std::vector<WireSpike> all(rank_ == root ? total / sizeof(WireSpike) : 0);
+    MPI_Gatherv(local.data(), count, MPI_BYTE, all.data(), counts.data(), displs.data(), MPI_BYTE, root, comm_);
+
+    std::vector<std::pair<double, size_t>> spikes;
+    spikes.reserve(all.size());
+    for (const auto& s : all) spikes.emplace_back(s.time, s.neuron);
+    std::sort(spikes.begin(), spikes.end());
+    return spikes;
+}
+
+std::vector<double> DistributedNetwork::gather_population_state(size_t population, size_t var, int root) {
+    if (population >= partitions_.size()) throw std::out_of_range("Population index out of bounds");
+    const Partition& p = partitions_[population];
+    std::vector<double> local;
+    if (p.local_population >= 0) local = local_.get_population_state(p.local_population, var);
+
+    // Blocks are contiguous and ordered by rank
+    std::vector<int> counts(n_ranks_), displs(n_ranks_);
+    for (int r = 0; r < n_ranks_; ++r) {
+        counts[r] = static_cast<int>(block_begin(p, r + 1) - block_begin(p, r));
+        displs[r] = static_cast<int>(block_begin(p, r));
+    }
+    std::vector<double> all(rank_ == root ? p.size : 0);
+    MPI_Gatherv(local.data(), static_cast<int>(local.size()), MPI_DOUBLE,
+                all.data(), counts.data(), displs.data(), MPI_DOUBLE, root, comm_);
+    return all;
+}
+
+void DistributedNetwork::reset_spikes() {
+    spikes_.clear();
+}
@@ -0,0 +1,165 @@
+#include "ExpCurrentLIFNeuron.h"
+#include <cmath>
+#include <algorithm>
+#include <omp.h>
+#include <limits>
+
+ExpCurrentLIFNeuron::ExpCurrentLIFNeuron(double tau_m, double tau_syn, double C_m, double v_rest, double v_reset, double v_thresh, double refractory)
+    : tau_m_(tau_m),
+      tau_syn_(tau_syn),
+      C_m_(C_m),
+      v_rest_(v_rest),
+      v_reset_(v_reset),
+      v_thresh_(v_thresh),
+      refractory_(refractory) {}
+
+size_t ExpCurrentLIFNeuron::get_num_state_vars() {
+    return 2;
+}
+
+double ExpCurrentLIFNeuron::get_init_state(size_t var) {
+    return var == 0 ? v_reset_ : 0.0;
+}
+
+std::vector<std::string> ExpCurrentLIFNeuron::get_param_names() {
+    return {"tau_m", "tau_syn", "C_m", "v_rest", "v_reset", "v_thresh", "refractory"};
+}
+
+double ExpCurrentLIFNeuron::get_param_value(size_t p) {
+    const double values[NUM_PARAMS] = {tau_m_, tau_syn_, C_m_, v_rest_, v_reset_, v_thresh_, refractory_};
+    return p < NUM_PARAMS ? values[p] : 0.0;
+}
+
+bool ExpCurrentLIFNeuron::receive_vars(double t, double charge, double* const* vars, double* last_spike, double* last_update) {
+    const bool hetero = vars[2] != nullptr;
+    const double tau_syn = hetero ? vars[2 + TAU_SYN][0] : tau_syn_;
+    const double refractory = hetero ? vars[2 + REFRACTORY][0] : refractory_;
+    const double v_thresh = hetero ? vars[2 + V_THRESH][0] : v_thresh_;
+    const double v_reset = hetero ? vars[2 + V_RESET][0] : v_reset_;
+
+    // The current keeps integrating during the refractory period
+    vars[1][0] += charge / tau_syn;
+
+    if (__builtin_expect((t - *last_spike) < refractory, 0))
+        return false;
+
+    if (__builtin_expect(vars[0][0] >= v_thresh, 0)) {
+        vars[0][0] = v_reset;
+        *last_spike = t;
+        return true;
+    }
+    return false;
+}
+
+bool ExpCurrentLIFNeuron::predicts_spikes(double* const* vars, size_t n) {
+    return true;
+}
+
+double ExpCurrentLIFNeuron::next_spike_time(double* const* vars, double* last_spike, double* last_update) {
+    constexpr double INF = std::numeric_limits<double>::infinity();
+    const bool hetero = vars[2] != nullptr;
+    auto param = [&](int p, double scalar) { return hetero ? vars[2 + p][0] : scalar; };
+    const double tau_m = param(TAU_M, tau_m_);
+    const double tau_syn = param(TAU_SYN, tau_syn_);
+    const double C_m = param(C_M, C_m_);
+    const double v_rest = param(V_REST, v_rest_);
+    const double v_thresh = param(V_THRESH, v_thresh_);
+
+    // Free trajectory from the end of the refractory period (or from last_update), as in decay_vars
+    const double t_free = *last_spike + param(REFRACTORY, refractory_);
+    const double t0 = std::max(*last_update, t_free);
+    const double I0 = vars[1][0] * std::exp(-(t0 - *last_update) / tau_syn);
+    const double u0 = (t0 > *last_update ? param(V_RESET, v_reset_) : vars[0][0]) - v_rest;
+    const double u_thresh = v_thresh - v_rest;
+    if (u0 >= u_thresh) return t0 > *last_spike ? t0 : INF;
+    // Without current u relaxes to rest - it crosses only if the threshold lies below rest
+    if (I0 == 0.0) return u_thresh < 0.0 ? t0 + tau_m * std::log(u0 / u_thresh) : INF;
+
+    // The trajectory has at most one extremum s_peak and relaxes to rest (u = 0) after it
+    const bool degenerate = std::abs(tau_m - tau_syn) < 1e-12 * tau_m;
+    const double A = degenerate ? 0.0 : I0 * tau_m * tau_syn / (C_m * (tau_syn - tau_m));
+    auto u = [&](double s) {
+        // tau_m == tau_syn: u(s) = (u0 + I0 s / C_m) e^(-s/tau_m), as in decay_vars
+        if (degenerate) return (u0 + I0 * s / C_m) * std::exp(-s / tau_m);
+        return (u0 - A) * std::exp(-s / tau_m) + A * std::exp(-s / tau_syn);
+    };
+    double s_peak = 0.0;
+    if (degenerate) {
+        s_peak = std::max(0.0, tau_m - u0 * C_m / I0);
+    } else {
+        double ratio = -(u0 - A) * tau_syn / (A * tau_m);
+        if (ratio > 0.0) s_peak = std::max(0.0, std::log(ratio) / (1.0 / tau_m - 1.0 / tau_syn));
+    }
+
+    // u is monotonic on [0, s_peak] and on [s_peak, inf): the first crossing is on the rise to a maximum,
+    // or else on the relaxation towards rest when the threshold lies below it
+    double lo, hi;
+    if (s_peak > 0.0 && u(s_peak) >= u_thresh) {
+        lo = 0.0;
+        hi = s_peak;
+    } else if (u_thresh < 0.0) {
+        lo = s_peak;
+        double width = std::max(tau_m, tau_syn);
+        for (int it = 0; it < 64 && u(lo + width) < u_thresh; ++it) width *= 2.0;
+        hi = lo + width;
+        if (u(hi) < u_thresh) return INF;
+    } else {
+        return INF;
+    }
+    for (int it = 0; it < 64 && hi - lo > 1e-15 * (1.0 + t0); ++it) {
+        double mid = 0.5 * (lo + hi);
+        if (u(mid) >= u_thresh) hi = mid;
+        else lo = mid;
+    }
+    return t0 + hi;
+}
+
+bool ExpCurrentLIFNeuron::fire_vars(double t, double* const* vars, double* last_spike, double* last_update) {
+    vars[0][0] = vars[2] ? vars[2 + V_RESET][0] : v_reset_;
+    *last_spike = t;
+    return true;
+}
+
+void ExpCurrentLIFNeuron::decay_vars(double t, double* const* vars, double* last_spike, double* last_update, size_t n) {
+    if (vars[2]) decay_kernel<true>(t, vars, last_spike, last_update, n);
+    else decay_kernel<false>(t, vars, last_spike, last_update, n);
+}
+
+// Homogeneous populations read the scalar members, so the parameter loads are hoisted out of the loop
+template<bool Heterogeneous>
+void ExpCurrentLIFNeuron::decay_kernel(double t, double* const* vars, double* last_spike, double* last_update, size_t n) {
+    double* v = vars[0];
+    double* I = vars[1];
+    const double scalars[NUM_PARAMS] = {tau_m_, tau_syn_, C_m_, v_rest_, v_reset_, v_thresh_, refractory_};
+    double* const* params = vars + 2;
+    auto param = [&](int p, size_t i) { return Heterogeneous ? params[p][i] : scalars[p]; };
+
+    #pragma omp parallel for simd schedule(static) if(omp_get_max_threads() > 1)
+    for (size_t i = 0; i < n; ++i) {
+        const double tau_m = param(TAU_M, i);
+        const double tau_syn = param(TAU_SYN, i);
+        const double v_rest = param(V_REST, i);
+        const double v_reset = param(V_RESET, i);
+        // Amplitude of the current-driven term: v(dt) = v_rest + (u0 - A) e^(-dt/tau_m) + A e^(-dt/tau_syn), A = kappa * I0
+        const bool degenerate = std::abs(tau_m - tau_syn) < 1e-12 * tau_m;
+        const double kappa = degenerate ? 0.0 : tau_m * tau_syn / (param(C_M, i) * (tau_syn - tau_m));
+
+        // Integration of v starts when the refractory period ends
+        double t_free = last_spike[i] + param(REFRACTORY, i);
+        double t0 = std::max(last_update[i], t_free);
+        double refractory_mask = t >= t_free;  // 1.0 or 0.0
+        double t_end = refractory_mask * t + (1.0 - refractory_mask) * t0;
+
+        double I0 = I[i] * std::exp(-(t0 - last_update[i]) / tau_syn);
+        double dt = t_end - t0;
+        double em = std::exp(-dt / tau_m);
+        double es = std::exp(-dt / tau_syn);
+        double u0 = (t0 > last_update[i] ? v_reset : v[i]) - v_rest;
+        double u = degenerate ? (u0 + I0 * dt / param(C_M, i)) * em
+                              : (u0 - kappa * I0) * em + kappa * I0 * es;
+
+        v[i] = refractory_mask * (v_rest + u) + (1.0 - refractory_mask) * v_reset;
+        I[i] = I[i] * std::exp(-(t - last_update[i]) / tau_syn);
+        last_update[i] = t;
+    }
+}
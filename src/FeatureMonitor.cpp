@@ -0,0 +1,66 @@
+#include "FeatureMonitor.h"
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+
+FeatureMonitor::FeatureMonitor(size_t first_neuron, size_t n_neurons, double bin_width, size_t n_bins, double tau)
+    : counts(n_bins * n_neurons, 0.0),
+      traces(tau > 0.0 ? n_bins * n_neurons : 0, 0.0),
+      first_neuron_(first_neuron),
+      n_neurons_(n_neurons),
+      bin_width_(bin_width),
+      n_bins_(n_bins),
+      tau_(tau),
+      started_(false),
+      origin_(0.0),
+      filtered_bins_(0) {
+    if (bin_width <= 0.0) throw std::invalid_argument("FeatureMonitor: bin width must be positive");
+}
+
+void FeatureMonitor::on_spike(double time, size_t neuron_id) {
+    size_t i = neuron_id - first_neuron_;   // wraps around for neurons below the range
+    if (i >= n_neurons_ || time < origin_) return;
+    double bin = (time - origin_) / bin_width_;
+    if (bin >= static_cast<double>(n_bins_)) return;
+    counts[static_cast<size_t>(bin) * n_neurons_ + i] += 1.0;
+}
+
+void FeatureMonitor::on_run_start(double time) {
+    if (started_) return;
+    origin_ = time;
+    started_ = true;
+}
+
+void FeatureMonitor::on_run_end(double time) {
+    if (tau_ <= 0.0) return;
+
+    // The bin containing the current time may still receive spikes - it is filtered again next run
+    double last = std::floor((time - origin_) / bin_width_);
+    size_t end_bin = std::min(n_bins_, static_cast<size_t>(std::max(last, 0.0)) + 1);
+    const double decay = std::exp(-bin_width_ / tau_);
+    const double impulse = 1.0 / bin_width_;
+
+    for (size_t b = filtered_bins_; b < end_bin; ++b) {
+        const double* cnt = &counts[b * n_neurons_];
+        double* out = &traces[b * n_neurons_];
+        if (b == 0) {
+            #pragma omp simd
+            for (size_t i = 0; i < n_neurons_; ++i)
+                out[i] = cnt[i] * impulse;
+        } else {
+            const double* prev = &traces[(b - 1) * n_neurons_];
+            #pragma omp simd
+            for (size_t i = 0; i < n_neurons_; ++i)
+                out[i] = prev[i] * decay + cnt[i] * impulse;
+        }
+    }
+    if (end_bin > 0) filtered_bins_ = std::max(filtered_bins_, end_bin - 1);
+}
+
+void FeatureMonitor::reset_recording() {
+    std::fill(counts.begin(), counts.end(), 0.0);
+    std::fill(traces.begin(), traces.end(), 0.0);
+    started_ = false;
+    origin_ = 0.0;
+    filtered_bins_ = 0;
+}
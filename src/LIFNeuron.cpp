@@ -2,15 +2,18 @@
 #include <cmath>
 #include <iostream>
 #include <omp.h>
+#include <algorithm>
+#include <limits>
 
-LIFNeuron::LIFNeuron(double tau_m, double C_m, double v_rest, double v_reset, double v_thresh, double refractory)
+LIFNeuron::LIFNeuron(double tau_m, double C_m, double v_rest, double v_reset, double v_thresh, double refractory, double i_bias)
     : tau_m_(tau_m),
       C_m_(C_m),
       inv_C_m_(1/C_m),
       v_rest_(v_rest),
       v_reset_(v_reset),
       v_thresh_(v_thresh),
-      refractory_(refractory) {}
+      refractory_(refractory),
+      i_bias_(i_bias) {}
 
 bool LIFNeuron::receive(double t, double charge, double* state, double* last_spike, double* last_update) {
     double last_spk = *last_spike;
@@ -29,7 +32,8 @@ bool LIFNeuron::receive(double t, double charge, double* state, double* last_spi
 }
 
 void LIFNeuron::decay(double t, double* state, double* last_spike, double* last_update, size_t n=1) {
-    const double v_rest = v_rest_;
+    // Resting point shifted by the bias current
+    const double v_rest = v_rest_ + i_bias_ * tau_m_ * inv_C_m_;
     const double tau_m  = tau_m_;
 
     if (omp_get_max_threads() == 1){ // single-threaded
@@ -61,4 +65,100 @@ void LIFNeuron::decay(double t, double* state, double* last_spike, double* last_
 
 double LIFNeuron::get_init_value() {
     return v_reset_;
+}
+
+std::vector<std::string> LIFNeuron::get_param_names() {
+    return {"tau_m", "C_m", "v_rest", "v_reset", "v_thresh", "refractory", "i_bias"};
+}
+
+double LIFNeuron::get_param_value(size_t p) {
+    switch (p) {
+        case TAU_M: return tau_m_;
+        case C_M: return C_m_;
+        case V_REST: return v_rest_;
+        case V_RESET: return v_reset_;
+        case V_THRESH: return v_thresh_;
+        case REFRACTORY: return refractory_;
+        case I_BIAS: return i_bias_;
+        default: return 0.0;
+    }
+}
+
+bool LIFNeuron::receive_vars(double t, double charge, double* const* vars, double* last_spike, double* last_update) {
+    if (!vars[1]) return receive(t, charge, vars[0], last_spike, last_update);
+    double* const* params = vars + 1;
+
+    double last_spk = *last_spike;
+    if (__builtin_expect((t - last_spk) < params[REFRACTORY][0], 0))
+        return false;
+
+    double v = *vars[0] + charge / params[C_M][0];
+    if (__builtin_expect(v >= params[V_THRESH][0], 0)) {
+        *vars[0] = params[V_RESET][0];
+        *last_spike = t;
+        return true;
+    }
+
+    *vars[0] = v;
+    return false;
+}
+
+void LIFNeuron::decay_vars(double t, double* const* vars, double* last_spike, double* last_update, size_t n) {
+    if (!vars[1]) return decay(t, vars[0], last_spike, last_update, n);
+    double* state = vars[0];
+    const double* tau_m = vars[1 + TAU_M];
+    const double* C_m = vars[1 + C_M];
+    const double* v_rest = vars[1 + V_REST];
+    const double* i_bias = vars[1 + I_BIAS];
+    const double* v_reset = vars[1 + V_RESET];
+    const double* refractory = vars[1 + REFRACTORY];
+
+    // Same kernel as decay, reading the parameters from their arrays
+    #pragma omp parallel for simd schedule(static) if(omp_get_max_threads() > 1)
+    for (size_t i = 0; i < n; ++i) {
+        double dt = t - last_update[i];
+        double refractory_mask = (t - last_spike[i]) >= refractory[i];  // 1.0 or 0.0
+        double decay_factor = std::exp(-dt / tau_m[i]);
+        double v_inf = v_rest[i] + i_bias[i] * tau_m[i] / C_m[i];
+        double v_new = v_inf + (state[i] - v_inf) * decay_factor;
+
+        // Apply only if not refractory
+        state[i] = refractory_mask * v_new + (1.0 - refractory_mask) * v_reset[i];
+        last_update[i] = refractory_mask * t + (1.0 - refractory_mask) * last_update[i];
+    }
+}
+
+bool LIFNeuron::predicts_spikes(double* const* vars, size_t n) {
+    if (!vars[1]) return i_bias_ != 0.0;
+    const double* i_bias = vars[1 + I_BIAS];
+    for (size_t i = 0; i < n; ++i)
+        if (i_bias[i] != 0.0) return true;
+    return false;
+}
+
+double LIFNeuron::next_spike_time(double* const* vars, double* last_spike, double* last_update) {
+    const bool hetero = vars[1] != nullptr;
+    auto param = [&](int p, double scalar) { return hetero ? vars[1 + p][0] : scalar; };
+    const double tau_m = param(TAU_M, tau_m_);
+    const double v_thresh = param(V_THRESH, v_thresh_);
+    const double v_inf = param(V_REST, v_rest_) + param(I_BIAS, i_bias_) * tau_m / param(C_M, C_m_);
+    const double v = *vars[0];
+
+    // Decay keeps counting from last_update through the refractory period, so the crossing follows
+    // v(t) = v_inf + (v - v_inf) exp(-(t - last_update) / tau_m), but cannot happen while refractory
+    const double t_free = *last_spike + param(REFRACTORY, refractory_);
+    if (v >= v_thresh) {
+        // Guard against firing twice at the same time (reset above threshold without refractory period)
+        double t_fire = std::max(t_free, *last_update);
+        return t_fire > *last_spike ? t_fire : std::numeric_limits<double>::infinity();
+    }
+    if (v_inf <= v_thresh) return std::numeric_limits<double>::infinity();
+    double t_cross = *last_update + tau_m * std::log((v_inf - v) / (v_inf - v_thresh));
+    return std::max(t_free, t_cross);
+}
+
+bool LIFNeuron::fire_vars(double t, double* const* vars, double* last_spike, double* last_update) {
+    *vars[0] = vars[1] ? vars[1 + V_RESET][0] : v_reset_;
+    *last_spike = t;
+    return true;
 }
\ No newline at end of file
@@ -0,0 +1,77 @@
+#include "Layout.h"
+#include <algorithm>
+#include <numeric>
+#include <cstdint>
+
+template <class Weight>
+std::vector<size_t> reverse_cuthill_mckee(const BasicSynapseMatrix<Weight>& synapses) {
+    const size_t n = synapses.num_rows();
+
+    // Undirected adjacency in CSR form, self-loops dropped (duplicates are harmless)
+    std::vector<size_t> adj_ptr(n + 1, 0);
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t s = synapses.row_ptr[i]; s < synapses.row_ptr[i + 1]; ++s) {
+            if (synapses.dst[s] == i) continue;
+            ++adj_ptr[i + 1];
+            ++adj_ptr[synapses.dst[s] + 1];
+        }
+    }
+    std::partial_sum(adj_ptr.begin(), adj_ptr.end(), adj_ptr.begin());
+    std::vector<size_t> adj(adj_ptr[n]);
+    std::vector<size_t> fill(adj_ptr.begin(), adj_ptr.end() - 1);
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t s = synapses.row_ptr[i]; s < synapses.row_ptr[i + 1]; ++s) {
+            size_t j = synapses.dst[s];
+            if (j == i) continue;
+            adj[fill[i]++] = j;
+            adj[fill[j]++] = i;
+        }
+    }
+    auto degree = [&](size_t i) { return adj_ptr[i + 1] - adj_ptr[i]; };
+    auto by_degree = [&](size_t a, size_t b) { return degree(a) < degree(b); };
+
+    std::vector<size_t> starts(n);
+    std::iota(starts.begin(), starts.end(), 0);
+    std::stable_sort(starts.begin(), starts.end(), by_degree);
+
+    // Breadth-first (Cuthill-McKee) order - the queue is the order itself
+    std::vector<size_t> order;
+    order.reserve(n);
+    std::vector<uint8_t> visited(n, 0);
+    std::vector<size_t> neighbours;
+    for (size_t start : starts) {
+        if (visited[start]) continue;
+        visited[start] = 1;
+        order.push_back(start);
+        for (size_t head = order.size() - 1; head < order.size(); ++head) {
+            size_t v = order[head];
+            neighbours.clear();
+            for (size_t k = adj_ptr[v]; k < adj_ptr[v + 1]; ++k) {
+                if (visited[adj[k]]) continue;
+                visited[adj[k]] = 1;
+                neighbours.push_back(adj[k]);
+            }
+            std::stable_sort(neighbours.begin(), neighbours.end(), by_degree);
+            order.insert(order.end(), neighbours.begin(), neighbours.end());
+        }
+    }
+    std::reverse(order.begin(), order.end());
+    return order;
+}
+
+template <class Weight>
+size_t layout_bandwidth(const BasicSynapseMatrix<Weight>& synapses, const std::vector<size_t>& position) {
+    size_t bandwidth = 0;
+    for (size_t i = 0; i < synapses.num_rows(); ++i) {
+        for (size_t s = synapses.row_ptr[i]; s < synapses.row_ptr[i + 1]; ++s) {
+            size_t a = position[i], b = position[synapses.dst[s]];
+            bandwidth = std::max(bandwidth, a > b ? a - b : b - a);
+        }
+    }
+    return bandwidth;
+}
+
+template std::vector<size_t> reverse_cuthill_mckee(const BasicSynapseMatrix<float>&);
+template std::vector<size_t> reverse_cuthill_mckee(const BasicSynapseMatrix<double>&);
+template size_t layout_bandwidth(const BasicSynapseMatrix<float>&, const std::vector<size_t>&);
+template size_t layout_bandwidth(const BasicSynapseMatrix<double>&, const std::vector<size_t>&);
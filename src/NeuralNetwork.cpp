@@ -1,25 +1,54 @@
 #include "NeuralNetwork.h"
+#include "InputNeuron.h"
+#include "Layout.h"
 #include <memory>
 #include <stdexcept>
 #include <vector>
 #include <iostream>
 #include <limits>
+#include <algorithm>
+#include <numeric>
 #include <omp.h>
 
+// Networks with more distinct delays use the priority queue only
+static constexpr size_t DEFAULT_DELAY_LANES = 16;
+
 // Always initialize with 1 thread
-NeuralNetwork::NeuralNetwork() : num_exec_threads_(1) {
+template <class Weight>
+BasicNeuralNetwork<Weight>::BasicNeuralNetwork()
+    : pending_batches_(0), armed_(false), step_(0.0), staged_synapses_(0), delay_groups_stale_(false),
+      max_delay_lanes_(DEFAULT_DELAY_LANES), readings_armed_(false), reading_origin_(0.0), reading_count_(0),
+      next_reading_(std::numeric_limits<double>::quiet_NaN()), num_exec_threads_(1) {
     omp_set_num_threads(num_exec_threads_);
     sim_time = 0.0;
 }
 
-void NeuralNetwork::add_neuron_population(size_t size, std::shared_ptr<Neuron> neuron_type) {
+template <class Weight>
+void BasicNeuralNetwork<Weight>::add_neuron_population(size_t size, std::shared_ptr<Neuron> neuron_type) {
+    size_t n_vars = neuron_type->get_num_state_vars();
+    if (n_vars == 0 || n_vars > NeuronPopulation::MAX_STATE_VARS)
+        throw std::invalid_argument("Unsupported number of neuron state variables");
+
+    if (neuron_type->get_param_names().size() > NeuronPopulation::MAX_PARAMS)
+        throw std::invalid_argument("Unsupported number of neuron parameters");
+
     size_t prev_size = neuron_states_.size();
     // Increase vectors to handle new state variables
     neuron_states_.resize(prev_size + size, neuron_type->get_init_value());
     neuron_last_spikes_.resize(prev_size + size, -std::numeric_limits<double>::infinity());
     neuron_last_updates_.resize(prev_size + size, 0.0);
     neuron_types_.resize(prev_size + size, neuron_type);
+    neuron_population_ids_.resize(prev_size + size, static_cast<uint32_t>(neuron_populations_.size()));
+    neuron_predicted_spikes_.resize(prev_size + size, std::numeric_limits<double>::infinity());
     adjacency_.resize(prev_size + size);
+    // New neurons are stored in id order
+    if (!to_internal_.empty()) {
+        for (size_t i = prev_size; i < prev_size + size; ++i) {
+            to_internal_.push_back(i);
+            to_external_.push_back(i);
+        }
+        external_states_.resize(prev_size + size);
+    }
 
     // Recalculate pointers to new vector position
     size_t offset = 0;
@@ -27,6 +56,7 @@ void NeuralNetwork::add_neuron_population(size_t size, std::shared_ptr<Neuron> n
         pop->state_addr       = &(neuron_states_[offset]);
         pop->last_spike_addr  = &(neuron_last_spikes_[offset]);
         pop->last_update_addr = &(neuron_last_updates_[offset]);
+        pop->update_state_vars();
         offset += pop->n_neurons;   // move to next block
     }
 
@@ -35,112 +65,864 @@ void NeuralNetwork::add_neuron_population(size_t size, std::shared_ptr<Neuron> n
         neuron_type,
         &(neuron_states_[prev_size]),
         &(neuron_last_spikes_[prev_size]),
-        &(neuron_last_updates_[prev_size])
+        &(neuron_last_updates_[prev_size]),
+        prev_size
     );
     neuron_populations_.push_back(std::move(new_pop));
+    armed_ = false;
+}
+
+template <class Weight>
+void BasicNeuralNetwork<Weight>::add_input_population(std::shared_ptr<SpikeGenerator> generator) {
+    generator_offsets_.push_back(neuron_states_.size());
+    add_neuron_population(generator->size(), std::make_shared<InputNeuron>());
+    generators_.push_back(std::move(generator));
 }
 
-void NeuralNetwork::add_synapse(const Synapse& synapse) {
+template <class Weight>
+void BasicNeuralNetwork<Weight>::add_synapse(const Synapse& synapse) {
     if (synapse.src_id >= neuron_states_.size() || synapse.dst_id >= neuron_states_.size()) {
         throw std::out_of_range("Neuron index out of bounds for synapse");
     }
     adjacency_[synapse.src_id].push_back(synapse);
+    ++staged_synapses_;
+}
+
+template <class Weight>
+const NeuronPopulation& BasicNeuralNetwork<Weight>::population_at(size_t population) const {
+    if (population >= neuron_populations_.size()) throw std::out_of_range("Population index out of bounds");
+    return *neuron_populations_[population];
+}
+
+template <class Weight>
+size_t BasicNeuralNetwork<Weight>::connect_random(size_t pre_pop, size_t post_pop, double p, const Distribution& weight, const Distribution& delay,
+                                     uint64_t seed, bool allow_autapses) {
+    const auto& pre = population_at(pre_pop);
+    const auto& post = population_at(post_pop);
+    size_t n = ::connect_random(adjacency_, pre.first_index, pre.n_neurons, post.first_index, post.n_neurons,
+                                p, weight, delay, seed, allow_autapses);
+    staged_synapses_ += n;
+    return n;
+}
+
+template <class Weight>
+size_t BasicNeuralNetwork<Weight>::connect_fixed_outdegree(size_t pre_pop, size_t post_pop, size_t k, const Distribution& weight, const Distribution& delay,
+                                              uint64_t seed, bool allow_autapses) {
+    const auto& pre = population_at(pre_pop);
+    const auto& post = population_at(post_pop);
+    size_t n = ::connect_fixed_outdegree(adjacency_, pre.first_index, pre.n_neurons, post.first_index, post.n_neurons,
+                                         k, weight, delay, seed, allow_autapses);
+    staged_synapses_ += n;
+    return n;
+}
+
+template <class Weight>
+size_t BasicNeuralNetwork<Weight>::connect_fixed_indegree(size_t pre_pop, size_t post_pop, size_t k, const Distribution& weight, const Distribution& delay,
+                                             uint64_t seed, bool allow_autapses) {
+    const auto& pre = population_at(pre_pop);
+    const auto& post = population_at(post_pop);
+    size_t n = ::connect_fixed_indegree(adjacency_, pre.first_index, pre.n_neurons, post.first_index, post.n_neurons,
+                                        k, weight, delay, seed, allow_autapses);
+    staged_synapses_ += n;
+    return n;
+}
+
+template <class Weight>
+size_t BasicNeuralNetwork<Weight>::connect_distance(size_t pre_pop, size_t post_pop,
+                                       const std::vector<double>& pre_positions, const std::vector<double>& post_positions,
+                                       double C, double lambda, const Distribution& weight, const Distribution& delay,
+                                       uint64_t seed, bool allow_autapses) {
+    const auto& pre = population_at(pre_pop);
+    const auto& post = population_at(post_pop);
+    if (pre_positions.size() != 3 * pre.n_neurons || post_positions.size() != 3 * post.n_neurons)
+        throw std::invalid_argument("connect_distance: one (x, y, z) position per neuron is required");
+    size_t n = ::connect_distance(adjacency_, pre.first_index, pre_positions, post.first_index, post_positions,
+                                  C, lambda, weight, delay, seed, allow_autapses);
+    staged_synapses_ += n;
+    return n;
+}
+
+template <class Weight>
+size_t BasicNeuralNetwork<Weight>::connect_small_world(size_t pop, size_t k, double beta, const Distribution& weight, const Distribution& delay,
+                                          uint64_t seed) {
+    const auto& p = population_at(pop);
+    size_t n = ::connect_small_world(adjacency_, p.first_index, p.n_neurons, k, beta, weight, delay, seed);
+    staged_synapses_ += n;
+    return n;
+}
+
+template <class Weight>
+void BasicNeuralNetwork<Weight>::build_synapses() {
+    bool append = staged_synapses_ > 0 || synapses_.num_rows() != size();
+    if (append || delay_groups_stale_) {
+        if (!event_queue_.empty()) expand_queued_packets();
+        if (append && !to_internal_.empty()) {
+            // Staged with user ids - moved to the rows of the storage positions
+            std::vector<std::vector<Synapse>> rows(adjacency_.size());
+            for (size_t i = 0; i < adjacency_.size(); ++i) {
+                for (auto& syn : adjacency_[i]) {
+                    syn.src_id = to_internal_[syn.src_id];
+                    syn.dst_id = to_internal_[syn.dst_id];
+                }
+                rows[to_internal_[i]].swap(adjacency_[i]);
+            }
+            adjacency_.swap(rows);
+        }
+        if (append) synapses_.append(adjacency_);
+        else synapses_.build_delay_groups();
+        staged_synapses_ = 0;
+        delay_groups_stale_ = false;
+        assign_delay_lanes();
+        // Batch windows depend on the delays
+        armed_ = false;
+    }
+    if (!stdp_rules_.empty() && !synapses_.has_reverse_index())
+        synapses_.build_reverse_index();
+}
+
+template <class Weight>
+void BasicNeuralNetwork<Weight>::assign_delay_lanes() {
+    // Distinct delays in order of first appearance
+    std::vector<double> lane_delays;
+    group_lanes_.assign(synapses_.num_groups(), EventQueue::NO_LANE);
+    for (size_t g = 0; g < synapses_.num_groups(); ++g) {
+        double delay = synapses_.delay[synapses_.group_ptr[g]];
+        auto it = std::find(lane_delays.begin(), lane_delays.end(), delay);
+        if (it == lane_delays.end()) {
+            if (lane_delays.size() == max_delay_lanes_) {
+                std::fill(group_lanes_.begin(), group_lanes_.end(), EventQueue::NO_LANE);
+                return;
+            }
+            lane_delays.push_back(delay);
+            it = lane_delays.end() - 1;
+        }
+        group_lanes_[g] = static_cast<uint32_t>(it - lane_delays.begin());
+    }
+    event_queue_.set_num_lanes(lane_delays.size());
+}
+
+template <class Weight>
+void BasicNeuralNetwork<Weight>::expand_queued_packets() {
+    for (const PacketEvent& packet : event_queue_.take_packets())
+        for (size_t s = synapses_.group_ptr[packet.group]; s < synapses_.group_ptr[packet.group + 1]; ++s)
+            event_queue_.push(SpikeEvent{packet.time, synapses_.dst[s], synapses_.weight[s]});
+}
+
+template <class Weight>
+void BasicNeuralNetwork<Weight>::set_max_delay_lanes(size_t k) {
+    max_delay_lanes_ = k;
+    // Packets already queued keep their lane
+    assign_delay_lanes();
+}
+
+template <class Weight>
+std::vector<Synapse> BasicNeuralNetwork<Weight>::get_synapses() {
+    build_synapses();
+    std::vector<Synapse> synapses;
+    synapses.reserve(synapses_.size());
+    for (size_t i = 0; i < synapses_.num_rows(); ++i)
+        for (size_t s = synapses_.row_ptr[i]; s < synapses_.row_ptr[i + 1]; ++s)
+            synapses.emplace_back(to_external(i), to_external(synapses_.dst[s]), synapses_.weight[s], synapses_.delay[s]);
+    return synapses;
+}
+
+template <class Weight>
+size_t BasicNeuralNetwork<Weight>::num_synapses() {
+    build_synapses();
+    return synapses_.size();
+}
+
+template <class Weight>
+std::vector<Weight>& BasicNeuralNetwork<Weight>::get_weights() {
+    build_synapses();
+    return synapses_.weight;
+}
+
+template <class Weight>
+const std::vector<double>& BasicNeuralNetwork<Weight>::get_delays() {
+    build_synapses();
+    return synapses_.delay;
+}
+
+template <class Weight>
+void BasicNeuralNetwork<Weight>::set_weights(const std::vector<Weight>& weights) {
+    build_synapses();
+    if (weights.size() != synapses_.size()) throw std::invalid_argument("set_weights: one weight per synapse is required");
+    std::copy(weights.begin(), weights.end(), synapses_.weight.begin());
+}
+
+template <class Weight>
+void BasicNeuralNetwork<Weight>::set_delays(const std::vector<double>& delays) {
+    build_synapses();
+    if (delays.size() != synapses_.size()) throw std::invalid_argument("set_delays: one delay per synapse is required");
+    if (std::any_of(delays.begin(), delays.end(), [](double d) { return d < 0.0; }))
+        throw std::invalid_argument("set_delays: delays must be non-negative");
+    std::copy(delays.begin(), delays.end(), synapses_.delay.begin());
+    delay_groups_stale_ = true;
 }
 
-void NeuralNetwork::set_spike_monitor(std::shared_ptr<SpikeMonitor> monitor) {
+template <class Weight>
+void BasicNeuralNetwork<Weight>::scale_weights(size_t pre_pop, size_t post_pop, double factor) {
+    const auto& pre = population_at(pre_pop);
+    const auto& post = population_at(post_pop);
+    build_synapses();
+    const size_t row_begin = synapses_.row_ptr[pre.first_index];
+    const size_t row_end = synapses_.row_ptr[pre.first_index + pre.n_neurons];
+    const size_t post_begin = post.first_index;
+    const size_t n_post = post.n_neurons;
+    Weight* weight = synapses_.weight.data();
+    const auto* dst = synapses_.dst.data();
+
+    #pragma omp parallel for simd schedule(static) if(omp_get_max_threads() > 1)
+    for (size_t s = row_begin; s < row_end; ++s)
+        weight[s] = dst[s] - post_begin < n_post ? weight[s] * factor : weight[s];
+}
+
+template <class Weight>
+void BasicNeuralNetwork<Weight>::add_stdp_rule(std::shared_ptr<STDPRule> rule) {
+    if (rule->pre_begin_ + rule->n_pre_ > size() || rule->post_begin_ + rule->n_post_ > size())
+        throw std::out_of_range("STDP projection out of bounds");
+    stdp_rules_.push_back(std::move(rule));
+}
+
+template <class Weight>
+void BasicNeuralNetwork<Weight>::add_projection(std::shared_ptr<Projection> projection) {
+    if (projection->pre_begin_ + projection->n_pre_ > size() || projection->post_begin_ + projection->n_post_ > size())
+        throw std::out_of_range("Projection out of bounds");
+    projections_.push_back(std::move(projection));
+    armed_ = false;
+}
+
+template <class Weight>
+std::shared_ptr<CompressedProjection> BasicNeuralNetwork<Weight>::compress_synapses(size_t pre_pop, size_t post_pop,
+                                                                                  CompressedProjection::WeightBits bits,
+                                                                                  double weight_scale) {
+    const auto& pre = population_at(pre_pop);
+    const auto& post = population_at(post_pop);
+    // Only staged synapses move - the ones already built into the CSR storage stay there
+    std::vector<std::vector<Synapse>> rows(pre.first_index + pre.n_neurons);
+    for (size_t i = pre.first_index; i < pre.first_index + pre.n_neurons; ++i) {
+        auto& staged = adjacency_[i];
+        auto moved = std::stable_partition(staged.begin(), staged.end(), [&](const Synapse& syn) {
+            return syn.dst_id - post.first_index >= post.n_neurons;
+        });
+        rows[i].assign(moved, staged.end());
+        staged.erase(moved, staged.end());
+        staged_synapses_ -= rows[i].size();
+    }
+
+    auto projection = std::make_shared<CompressedProjection>(pre.first_index, pre.n_neurons, post.first_index, post.n_neurons,
+                                                             bits, weight_scale);
+    projection->compress(rows);
+    add_projection(projection);
+    return projection;
+}
+
+template <class Weight>
+void BasicNeuralNetwork<Weight>::set_spike_monitor(std::shared_ptr<SpikeMonitor> monitor) {
     spike_monitor_ = monitor;
 }
 
-void NeuralNetwork::set_state_monitor(std::shared_ptr<StateMonitor> monitor) {
+template <class Weight>
+void BasicNeuralNetwork<Weight>::set_export_monitor(std::shared_ptr<SpikeMonitor> monitor) {
+    export_monitor_ = monitor;
+}
+
+template <class Weight>
+void BasicNeuralNetwork<Weight>::set_state_monitor(std::shared_ptr<StateMonitor> monitor) {
     state_monitor_ = monitor;
+    // The queued reading becomes stale - the new schedule starts at the next run
+    readings_armed_ = false;
+    next_reading_ = std::numeric_limits<double>::quiet_NaN();
+}
+
+template <class Weight>
+void BasicNeuralNetwork<Weight>::set_feature_monitor(std::shared_ptr<FeatureMonitor> monitor) {
+    feature_monitor_ = monitor;
 }
 
-void NeuralNetwork::schedule_spike_event(double time, size_t neuron_index, double weight) {
+template <class Weight>
+void BasicNeuralNetwork<Weight>::set_spike_count_monitor(std::shared_ptr<SpikeCountMonitor> monitor) {
+    spike_count_monitor_ = monitor;
+}
+
+template <class Weight>
+void BasicNeuralNetwork<Weight>::schedule_spike_event(double time, size_t neuron_index, double weight) {
     if (neuron_index >= neuron_states_.size()) throw std::out_of_range("Neuron index out of bounds");
     // Events added after current sim_time
-    event_queue_.push(SpikeEvent{sim_time + time, neuron_index, weight});
+    event_queue_.push(SpikeEvent{sim_time + time, to_internal(neuron_index), weight});
 }
 
-size_t NeuralNetwork::size() const {
+template <class Weight>
+void BasicNeuralNetwork<Weight>::schedule_absolute_spike_event(double time, size_t neuron_index, double weight) {
+    if (neuron_index >= neuron_states_.size()) throw std::out_of_range("Neuron index out of bounds");
+    event_queue_.push(SpikeEvent{time, to_internal(neuron_index), weight});
+}
+
+template <class Weight>
+void BasicNeuralNetwork<Weight>::schedule_spike_events(const std::vector<double>& times, const std::vector<size_t>& neuron_indices,
+                                                       const std::vector<double>& weights) {
+    if (times.size() != neuron_indices.size() || times.size() != weights.size())
+        throw std::invalid_argument("schedule_spike_events: times, neuron_indices and weights must have the same size");
+    for (size_t neuron_index : neuron_indices)
+        if (neuron_index >= neuron_states_.size()) throw std::out_of_range("Neuron index out of bounds");
+    for (size_t k = 0; k < times.size(); ++k)
+        event_queue_.push(SpikeEvent{sim_time + times[k], to_internal(neuron_indices[k]), weights[k]});
+}
+
+template <class Weight>
+size_t BasicNeuralNetwork<Weight>::size() const {
     return neuron_states_.size();
 }
 
-void NeuralNetwork::run(double T) {
-    // Schedule periodic update events
-    if (state_monitor_) {
-        for (double t = sim_time; t <= sim_time+T; t += state_monitor_->get_reading_interval())
-            event_queue_.push(UpdateEvent{t});
+template <class Weight>
+std::vector<double> BasicNeuralNetwork<Weight>::get_population_state(size_t population, size_t var) const {
+    if (population >= neuron_populations_.size()) throw std::out_of_range("Population index out of bounds");
+    const auto& pop = neuron_populations_[population];
+    if (var >= pop->n_state_vars) throw std::out_of_range("State variable index out of bounds");
+    std::vector<double> values(pop->state_vars[var], pop->state_vars[var] + pop->n_neurons);
+    if (!to_external_.empty()) {
+        for (size_t i = 0; i < pop->n_neurons; ++i)
+            values[to_external_[pop->first_index + i] - pop->first_index] = pop->state_vars[var][i];
+    }
+    return values;
+}
+
+template <class Weight>
+void BasicNeuralNetwork<Weight>::set_population_param(size_t population, const std::string& name, const std::vector<double>& values) {
+    if (population >= neuron_populations_.size()) throw std::out_of_range("Population index out of bounds");
+    auto& pop = neuron_populations_[population];
+    auto names = pop->neuron_class->get_param_names();
+    auto it = std::find(names.begin(), names.end(), name);
+    if (it == names.end()) throw std::invalid_argument("Neuron model has no per-neuron parameter " + name);
+    if (values.size() != pop->n_neurons) throw std::invalid_argument("Expected one parameter value per neuron");
+
+    pop->make_heterogeneous();
+    auto& param = pop->param_arrays[it - names.begin()];
+    for (size_t i = 0; i < pop->n_neurons; ++i)
+        param[to_internal(pop->first_index + i) - pop->first_index] = values[i];
+    armed_ = false;
+}
+
+template <class Weight>
+std::vector<double> BasicNeuralNetwork<Weight>::get_population_param(size_t population, const std::string& name) const {
+    if (population >= neuron_populations_.size()) throw std::out_of_range("Population index out of bounds");
+    const auto& pop = neuron_populations_[population];
+    auto names = pop->neuron_class->get_param_names();
+    auto it = std::find(names.begin(), names.end(), name);
+    if (it == names.end()) throw std::invalid_argument("Neuron model has no per-neuron parameter " + name);
+
+    size_t p = it - names.begin();
+    if (pop->param_arrays.empty())
+        return std::vector<double>(pop->n_neurons, pop->neuron_class->get_param_value(p));
+    std::vector<double> values(pop->n_neurons);
+    for (size_t i = 0; i < pop->n_neurons; ++i)
+        values[i] = pop->param_arrays[p][to_internal(pop->first_index + i) - pop->first_index];
+    return values;
+}
+
+template <class Weight>
+bool BasicNeuralNetwork<Weight>::deliver(double t, size_t neuron_index, double weight) {
+    const auto& pop = neuron_populations_[neuron_population_ids_[neuron_index]];
+
+    if (__builtin_expect(pop->batched_class != nullptr, 0)) {
+        // Gathered until the end of the window - the spikes are emitted when the batch is flushed
+        // Without outgoing synapses the window is infinite - flushed by the next state update or the end of the run
+        if (pop->batch_targets.empty()) {
+            pop->batch_flush_time = t + pop->batch_window;
+            ++pending_batches_;
+            if (pop->batch_flush_time != std::numeric_limits<double>::infinity())
+                event_queue_.push(BatchEvent{pop->batch_flush_time, neuron_population_ids_[neuron_index]});
+        }
+        pop->batch_targets.push_back(neuron_index - pop->first_index);
+        pop->batch_times.push_back(t);
+        pop->batch_charges.push_back(weight);
+        return false;
+    }
+
+    if (__builtin_expect(pop->uses_state_vars || pop->predicts_spikes, 0)) {
+        double* vars[NeuronPopulation::MAX_STATE_VARS + NeuronPopulation::MAX_PARAMS];
+        pop->neuron_state_vars(neuron_index - pop->first_index, vars);
+        pop->neuron_class->decay_vars(t, vars, &neuron_last_spikes_[neuron_index], &neuron_last_updates_[neuron_index], 1);
+        bool fired = pop->neuron_class->receive_vars(t, weight, vars, &neuron_last_spikes_[neuron_index], &neuron_last_updates_[neuron_index]);
+        if (pop->predicts_spikes) schedule_predicted_spike(*pop, neuron_index, vars);
+        return fired;
+    }
+
+    neuron_types_[neuron_index]->decay(
+        t,
+        &neuron_states_[neuron_index],
+        &neuron_last_spikes_[neuron_index], 
+        &neuron_last_updates_[neuron_index],
+        1
+    );
+
+    return neuron_types_[neuron_index]->receive(
+        t,
+        weight,
+        &neuron_states_[neuron_index],
+        &neuron_last_spikes_[neuron_index], 
+        &neuron_last_updates_[neuron_index]
+    );
+}
+
+template <class Weight>
+void BasicNeuralNetwork<Weight>::fire(double t, size_t neuron_index) {
+    // Monitors and projections see user ids
+    const size_t id = to_external(neuron_index);
+    if (spike_count_monitor_) spike_count_monitor_->on_spike(t, id);
+    if (spike_monitor_) spike_monitor_->on_spike(t, id);
+    if (export_monitor_) export_monitor_->on_spike(t, id);
+    if (feature_monitor_) feature_monitor_->on_spike(t, id);
+
+    // Weight updates before the spike is propagated
+    for (const auto& rule : stdp_rules_) {
+        if (rule->is_pre(neuron_index)) rule->on_pre_spike(t, neuron_index, synapses_);
+        if (rule->is_post(neuron_index)) rule->on_post_spike(t, neuron_index, synapses_);
+    }
+
+    // One packet per delay group - expanded into post-synaptic deliveries when it arrives
+    for (size_t g = synapses_.row_group[neuron_index]; g < synapses_.row_group[neuron_index + 1]; ++g) {
+        double arrivalTime = t + synapses_.delay[synapses_.group_ptr[g]];
+        event_queue_.push(PacketEvent{arrivalTime, g}, group_lanes_[g]);
+    }
+
+    for (size_t p = 0; p < projections_.size(); ++p) {
+        const auto& projection = projections_[p];
+        if (!projection->is_source(id)) continue;
+        const size_t n_groups = projection->num_groups(id);
+        for (size_t g = 0; g < n_groups; ++g)
+            event_queue_.push(ProjectionPacketEvent{t + projection->group_delay(id, g), static_cast<uint32_t>(p),
+                                                    static_cast<uint32_t>(g), id});
+        if (n_groups > 0) continue;
+        generated_synapses_.clear();
+        projection->generate(id, generated_synapses_);
+        for (const Synapse& syn : generated_synapses_)
+            event_queue_.push(SpikeEvent{t + syn.delay, to_internal(syn.dst_id), syn.weight});
+    }
+}
+
+template <class Weight>
+void BasicNeuralNetwork<Weight>::arm_generators() {
+    for (size_t g = 0; g < generators_.size(); ++g) {
+        auto& gen = generators_[g];
+        if (!gen->needs_arming()) continue;
+        // Previously queued events become stale as their pending times are overwritten
+        gen->arm(sim_time);
+        for (size_t i = 0; i < gen->size(); ++i) {
+            double t = gen->next_spike_time(i, sim_time);
+            if (t != std::numeric_limits<double>::infinity())
+                event_queue_.push(GeneratorEvent{t, g, i});
+        }
+    }
+}
+
+template <class Weight>
+void BasicNeuralNetwork<Weight>::schedule_predicted_spike(const NeuronPopulation& pop, size_t neuron_index, double* const* vars) {
+    double t = pop.neuron_class->next_spike_time(vars, &neuron_last_spikes_[neuron_index], &neuron_last_updates_[neuron_index]);
+    // Unchanged prediction - the queued event is still valid
+    if (t == neuron_predicted_spikes_[neuron_index]) return;
+    neuron_predicted_spikes_[neuron_index] = t;
+    if (t != std::numeric_limits<double>::infinity())
+        event_queue_.push(SelfSpikeEvent{t, neuron_index});
+}
+
+template <class Weight>
+void BasicNeuralNetwork<Weight>::arm_predictions() {
+    double* vars[NeuronPopulation::MAX_STATE_VARS + NeuronPopulation::MAX_PARAMS];
+    for (auto& pop : neuron_populations_) {
+        // Refreshed after API changes and direct edits of the model parameters only - O(populations) otherwise
+        bool changed = pop->model_params_changed();
+        if (armed_ && !changed) continue;
+        bool predicts = pop->neuron_class->predicts_spikes(pop->state_vars.data(), pop->n_neurons);
+        if (!predicts && pop->predicts_spikes) {
+            // Invalidate the crossings still queued
+            std::fill_n(&neuron_predicted_spikes_[pop->first_index], pop->n_neurons, std::numeric_limits<double>::infinity());
+        }
+        pop->predicts_spikes = predicts;
+        if (!predicts) continue;
+
+        for (size_t i = 0; i < pop->n_neurons; ++i) {
+            pop->neuron_state_vars(i, vars);
+            schedule_predicted_spike(*pop, pop->first_index + i, vars);
+        }
+    }
+}
+
+template <class Weight>
+void BasicNeuralNetwork<Weight>::arm_batches() {
+    for (auto& pop : neuron_populations_) {
+        if (!pop->batched_class) continue;
+        // A spike emitted at the start of the window must not reach its target before the window ends
+        double min_delay = std::numeric_limits<double>::infinity();
+        for (size_t s = synapses_.row_ptr[pop->first_index]; s < synapses_.row_ptr[pop->first_index + pop->n_neurons]; ++s)
+            min_delay = std::min(min_delay, synapses_.delay[s]);
+        for (const auto& projection : projections_) {
+            bool overlaps = projection->pre_begin_ < pop->first_index + pop->n_neurons &&
+                            pop->first_index < projection->pre_begin_ + projection->n_pre_;
+            if (overlaps) min_delay = std::min(min_delay, projection->min_delay());
+        }
+        double window = pop->batched_class->window_;
+        pop->batch_window = window > 0.0 ? std::min(window, min_delay) : min_delay;
+    }
+}
+
+template <class Weight>
+void BasicNeuralNetwork<Weight>::flush_batch(NeuronPopulation& pop) {
+    const size_t n = pop.batch_targets.size();
+    pop.batch_flush_time = std::numeric_limits<double>::infinity();
+    --pending_batches_;
+
+    pop.batch_fired.assign(n, 0);
+    pop.batched_class->process_batch(n, pop.batch_targets.data(), pop.batch_times.data(), pop.batch_charges.data(),
+                                     pop.state_addr, pop.last_spike_addr, pop.last_update_addr, pop.n_neurons,
+                                     pop.batch_fired.data());
+    for (size_t i = 0; i < n; ++i)
+        if (pop.batch_fired[i]) fire(pop.batch_times[i], pop.first_index + pop.batch_targets[i]);
+
+    pop.batch_targets.clear();
+    pop.batch_times.clear();
+    pop.batch_charges.clear();
+}
+
+template <class Weight>
+void BasicNeuralNetwork<Weight>::flush_batches() {
+    if (pending_batches_ == 0) return;
+    for (auto& pop : neuron_populations_)
+        if (!pop->batch_targets.empty()) flush_batch(*pop);
+}
+
+template <class Weight>
+void BasicNeuralNetwork<Weight>::check_batched_populations() const {
+    for (const auto& pop : neuron_populations_) {
+        if (!pop->batched_class) continue;
+        const size_t begin = pop->first_index, end = pop->first_index + pop->n_neurons;
+        auto overlaps = [&](size_t first, size_t n) { return first < end && begin < first + n; };
+        for (const auto& rule : stdp_rules_) {
+            if (overlaps(rule->pre_begin_, rule->n_pre_) || overlaps(rule->post_begin_, rule->n_post_))
+                throw std::logic_error("Batched populations cannot be covered by an STDP rule");
+        }
+        if (spike_count_monitor_ && spike_count_monitor_->get_window() > 0.0)
+            throw std::logic_error("Batched populations cannot be recorded by a windowed spike count monitor");
+        if (feature_monitor_ && overlaps(feature_monitor_->first_neuron_, feature_monitor_->n_neurons_))
+            throw std::logic_error("Batched populations cannot be recorded by a feature monitor");
+    }
+}
+
+template <class Weight>
+void BasicNeuralNetwork<Weight>::run(double T) {
+    // Storage is reserved up front and reused across runs, so the steady-state loop does not allocate
+    if (state_monitor_) state_monitor_->reserve(static_cast<size_t>(T / state_monitor_->get_reading_interval()) + 2, size());
+    event_queue_.reserve(event_queue_.size() + size() + 1);
+
+    run_until(sim_time + T);
+}
+
+template <class Weight>
+void BasicNeuralNetwork<Weight>::step() {
+    if (step_ <= 0.0) throw std::logic_error("step: no step interval set (see set_step)");
+    run_until(sim_time + step_);
+}
+
+template <class Weight>
+void BasicNeuralNetwork<Weight>::set_step(double dt) {
+    if (!(dt > 0.0)) throw std::invalid_argument("set_step: dt must be positive");
+    step_ = dt;
+}
+
+template <class Weight>
+double BasicNeuralNetwork<Weight>::get_step() const {
+    return step_;
+}
+
+template <class Weight>
+void BasicNeuralNetwork<Weight>::run_until(double t_end) {
+    if (t_end < sim_time) throw std::invalid_argument("run_until: t is before the current simulation time");
+
+    // No-ops unless the network changed since the last call
+    build_synapses();
+    arm_generators();
+    arm_predictions();
+    if (!armed_) arm_batches();
+    armed_ = true;
+    check_batched_populations();
+    if (state_monitor_ && !readings_armed_) {
+        reading_origin_ = sim_time;
+        reading_count_ = 0;
+        next_reading_ = sim_time;
+        event_queue_.push(UpdateEvent{sim_time});
+        readings_armed_ = true;
+    }
+    if (feature_monitor_) feature_monitor_->on_run_start(sim_time);
+    if (spike_count_monitor_) {
+        spike_count_monitor_->resize(size());
+        spike_count_monitor_->on_run_start(sim_time);
     }
 
     // Main simulation loop
-    while (!event_queue_.empty()) {
-        // Retrieve event and test if within simulation time
-        Event e = event_queue_.top();
-        event_queue_.pop();
-        // Get the time regardless of event type
-        auto get_time = [](const auto& ev) { return ev.time; };
-        if (std::visit(get_time, e) > sim_time+T) break;
+    while (true) {
+        // Events past the end of the run stay queued for the next one
+        if (event_queue_.empty() || event_queue_.next_time() > t_end) {
+            // Inputs still gathered by batched populations belong to this run
+            if (pending_batches_ == 0) break;
+            flush_batches();
+            continue;
+        }
+        Event e = event_queue_.pop();
 
         if (std::holds_alternative<SpikeEvent>(e)) {
             auto& spike = std::get<SpikeEvent>(e);
+            if (deliver(spike.time, spike.target_index, spike.weight))
+                fire(spike.time, spike.target_index);
+        }
+        if (std::holds_alternative<PacketEvent>(e)) {
+            auto& packet = std::get<PacketEvent>(e);
+            // Weights are read on arrival, so plasticity between emission and arrival is seen
+            for (size_t s = synapses_.group_ptr[packet.group]; s < synapses_.group_ptr[packet.group + 1]; ++s) {
+                if (deliver(packet.time, synapses_.dst[s], synapses_.weight[s]))
+                    fire(packet.time, synapses_.dst[s]);
+            }
+        }
+        if (std::holds_alternative<ProjectionPacketEvent>(e)) {
+            auto& packet = std::get<ProjectionPacketEvent>(e);
+            packet_synapses_.clear();
+            projections_[packet.projection]->generate_group(packet.source, packet.group, packet_synapses_);
+            for (const Synapse& syn : packet_synapses_) {
+                size_t target = to_internal(syn.dst_id);
+                if (deliver(packet.time, target, syn.weight))
+                    fire(packet.time, target);
+            }
+        }
+        if (std::holds_alternative<GeneratorEvent>(e)) {
+            auto& gen_spike = std::get<GeneratorEvent>(e);
+            auto& gen = generators_[gen_spike.generator_index];
 
-            neuron_types_[spike.target_index]->decay(
-                spike.time,
-                &neuron_states_[spike.target_index],
-                &neuron_last_spikes_[spike.target_index], 
-                &neuron_last_updates_[spike.target_index],
-                1
-            );
+            // Lazy invalidation - the source was rescheduled after this event was queued
+            if (gen->pending_spike_time(gen_spike.source_index) != gen_spike.time) continue;
 
-            if (neuron_types_[spike.target_index]->receive(
-                spike.time,
-                spike.weight,
-                &neuron_states_[spike.target_index],
-                &neuron_last_spikes_[spike.target_index], 
-                &neuron_last_updates_[spike.target_index]
-            )) {
-                if (spike_monitor_) spike_monitor_->on_spike(spike.time, spike.target_index);
-
-                // Schedules spike events to post-synaptic neurons
-                for (const auto& syn : adjacency_[spike.target_index]) {
-                    double arrivalTime = spike.time + syn.delay;
-                    event_queue_.push(SpikeEvent{arrivalTime, syn.dst_id, syn.weight});
-                }
-            }
+            size_t neuron_index = generator_offsets_[gen_spike.generator_index] + gen_spike.source_index;
+            neuron_last_spikes_[neuron_index] = gen_spike.time;
+            fire(gen_spike.time, neuron_index);
+
+            // Keep exactly one pending event per source
+            double next = gen->next_spike_time(gen_spike.source_index, gen_spike.time);
+            if (next != std::numeric_limits<double>::infinity())
+                event_queue_.push(GeneratorEvent{next, gen_spike.generator_index, gen_spike.source_index});
+        }
+        if (std::holds_alternative<SelfSpikeEvent>(e)) {
+            auto& self_spike = std::get<SelfSpikeEvent>(e);
+            size_t neuron_index = self_spike.neuron_index;
+
+            // Lazy invalidation - the neuron received input after this crossing was predicted
+            if (neuron_predicted_spikes_[neuron_index] != self_spike.time) continue;
+            neuron_predicted_spikes_[neuron_index] = std::numeric_limits<double>::infinity();
+
+            const auto& pop = neuron_populations_[neuron_population_ids_[neuron_index]];
+            double* vars[NeuronPopulation::MAX_STATE_VARS + NeuronPopulation::MAX_PARAMS];
+            pop->neuron_state_vars(neuron_index - pop->first_index, vars);
+            pop->neuron_class->decay_vars(self_spike.time, vars, &neuron_last_spikes_[neuron_index], &neuron_last_updates_[neuron_index], 1);
+            // Without a crossing the event only ended a prediction horizon - predicted again from here
+            if (pop->neuron_class->fire_vars(self_spike.time, vars, &neuron_last_spikes_[neuron_index], &neuron_last_updates_[neuron_index]))
+                fire(self_spike.time, neuron_index);
+            schedule_predicted_spike(*pop, neuron_index, vars);
+        }
+        if (std::holds_alternative<BatchEvent>(e)) {
+            auto& batch = std::get<BatchEvent>(e);
+            auto& pop = *neuron_populations_[batch.population];
+            // Lazy invalidation - the batch was flushed early by a state update
+            if (pop.batch_targets.empty() || pop.batch_flush_time != batch.time) continue;
+            flush_batch(pop);
         }
         if (std::holds_alternative<UpdateEvent>(e)) {
             auto& update = std::get<UpdateEvent>(e);
+            // Lazy invalidation - the state monitor was replaced, or this reading was already taken
+            if (update.time != next_reading_) continue;
+            update_states(update.time);
 
-            // Update all neurons to current time
-            for (const auto& pop : neuron_populations_) {
-                pop->neuron_class->decay(
-                    update.time,
-                    pop->state_addr,
-                    pop->last_spike_addr,
-                    pop->last_update_addr,
-                    pop->n_neurons
-                );
-            }
-            if (state_monitor_)
-                state_monitor_->on_read(update.time, neuron_states_);
+            // Keep exactly one pending reading - computed from the origin so that times do not drift
+            next_reading_ = reading_origin_ + static_cast<double>(++reading_count_) * state_monitor_->get_reading_interval();
+            event_queue_.push(UpdateEvent{next_reading_});
         }
     }
 
     // Update simulation time for subsequent runs
-    sim_time += T;
+    sim_time = t_end;
+    if (feature_monitor_) feature_monitor_->on_run_end(sim_time);
+    if (spike_count_monitor_) spike_count_monitor_->on_run_end(sim_time);
+}
+
+template <class Weight>
+void BasicNeuralNetwork<Weight>::update_states(double t) {
+    // Gathered inputs are older than the update
+    flush_batches();
+
+    // Update all neurons to current time
+    for (const auto& pop : neuron_populations_) {
+        if (pop->uses_state_vars) {
+            pop->neuron_class->decay_vars(
+                t,
+                pop->state_vars.data(),
+                pop->last_spike_addr,
+                pop->last_update_addr,
+                pop->n_neurons
+            );
+            continue;
+        }
+        pop->neuron_class->decay(
+            t,
+            pop->state_addr,
+            pop->last_spike_addr,
+            pop->last_update_addr,
+            pop->n_neurons
+        );
+    }
+    if (!to_external_.empty()) {
+        for (size_t i = 0; i < external_states_.size(); ++i)
+            external_states_[to_external_[i]] = neuron_states_[i];
+        state_monitor_->on_read(t, external_states_);
+    } else {
+        state_monitor_->on_read(t, neuron_states_);
+    }
+}
+
+template <class Weight>
+void BasicNeuralNetwork<Weight>::optimize_layout() {
+    if (sim_time != 0.0) throw std::logic_error("optimize_layout must be called before the first run");
+    build_synapses();
+
+    std::vector<size_t> position(size());
+    std::vector<size_t> order = reverse_cuthill_mckee(synapses_);
+    for (size_t k = 0; k < order.size(); ++k) position[order[k]] = k;
+
+    // Neurons are only reordered within their population, following their global RCM position
+    std::vector<size_t> perm(size());
+    std::iota(perm.begin(), perm.end(), 0);
+    for (const auto& pop : neuron_populations_) {
+        size_t begin = pop->first_index, end = pop->first_index + pop->n_neurons;
+        bool input = std::find(generator_offsets_.begin(), generator_offsets_.end(), begin) != generator_offsets_.end();
+        // Trace slots follow positions - the population must be entirely inside or outside every STDP range
+        auto split = [&](size_t range_begin, size_t range_size) {
+            bool overlaps = begin < range_begin + range_size && range_begin < end;
+            bool inside = range_begin <= begin && end <= range_begin + range_size;
+            return overlaps && !inside;
+        };
+        bool split_by_stdp = std::any_of(stdp_rules_.begin(), stdp_rules_.end(), [&](const auto& rule) {
+            return split(rule->pre_begin_, rule->n_pre_) || split(rule->post_begin_, rule->n_post_);
+        });
+        if (input || split_by_stdp) continue;
+        std::stable_sort(perm.begin() + begin, perm.begin() + end, [&](size_t a, size_t b) { return position[a] < position[b]; });
+    }
+    apply_layout(perm);
+}
+
+template <class Weight>
+void BasicNeuralNetwork<Weight>::apply_layout(const std::vector<size_t>& perm) {
+    const size_t n = size();
+    std::vector<size_t> inverse(n);
+    for (size_t k = 0; k < n; ++k) inverse[perm[k]] = k;
+
+    // Stored synapses are staged again with user ids and rebuilt at their new positions
+    if (!event_queue_.empty()) expand_queued_packets();
+    for (size_t i = 0; i < synapses_.num_rows(); ++i)
+        for (size_t s = synapses_.row_ptr[i]; s < synapses_.row_ptr[i + 1]; ++s)
+            adjacency_[to_external(i)].emplace_back(to_external(i), to_external(synapses_.dst[s]),
+                                                    synapses_.weight[s], synapses_.delay[s]);
+    staged_synapses_ = synapses_.size();
+    synapses_ = BasicSynapseMatrix<Weight>();
+
+    // In place - the populations keep pointers into these arrays
+    auto permute = [&](std::vector<double>& values, size_t offset) {
+        std::vector<double> permuted(values.size());
+        for (size_t i = 0; i < values.size(); ++i) permuted[i] = values[perm[offset + i] - offset];
+        std::copy(permuted.begin(), permuted.end(), values.begin());
+    };
+    permute(neuron_states_, 0);
+    permute(neuron_last_spikes_, 0);
+    permute(neuron_last_updates_, 0);
+    permute(neuron_predicted_spikes_, 0);
+    for (auto& pop : neuron_populations_) {
+        for (auto& values : pop->extra_states) permute(values, pop->first_index);
+        for (auto& values : pop->param_arrays) permute(values, pop->first_index);
+        pop->update_state_vars();
+    }
+
+    // Queued inputs follow their targets
+    event_queue_.for_each_event([&](Event& ev) {
+        if (auto* spike = std::get_if<SpikeEvent>(&ev)) spike->target_index = inverse[spike->target_index];
+        if (auto* self_spike = std::get_if<SelfSpikeEvent>(&ev)) self_spike->neuron_index = inverse[self_spike->neuron_index];
+    });
+
+    std::vector<size_t> to_external(n);
+    for (size_t k = 0; k < n; ++k) to_external[k] = this->to_external(perm[k]);
+    to_external_.swap(to_external);
+    to_internal_.assign(n, 0);
+    for (size_t k = 0; k < n; ++k) to_internal_[to_external_[k]] = k;
+    external_states_.assign(n, 0.0);
+
+    build_synapses();
+}
+
+template <class Weight>
+std::vector<size_t> BasicNeuralNetwork<Weight>::get_layout() const {
+    if (!to_external_.empty()) return to_external_;
+    std::vector<size_t> layout(size());
+    std::iota(layout.begin(), layout.end(), 0);
+    return layout;
 }
 
-void NeuralNetwork::reset_monitors() {
+template <class Weight>
+void BasicNeuralNetwork<Weight>::reserve_events(size_t n) {
+    event_queue_.reserve(n);
+}
+
+template <class Weight>
+void BasicNeuralNetwork<Weight>::reset_monitors() {
     // Reset monitors
     if (spike_monitor_) spike_monitor_->reset_spikes();
     if (state_monitor_) state_monitor_->reset_recording();
+    if (feature_monitor_) feature_monitor_->reset_recording();
+    if (spike_count_monitor_) spike_count_monitor_->reset_counts();
 }
 
-void NeuralNetwork::set_num_exec_threads(size_t n) {
+template <class Weight>
+void BasicNeuralNetwork<Weight>::reset() {
+    constexpr double INF = std::numeric_limits<double>::infinity();
+    event_queue_.clear();
+    sim_time = 0.0;
+
+    for (auto& pop : neuron_populations_) {
+        std::fill_n(pop->state_addr, pop->n_neurons, pop->neuron_class->get_init_value());
+        for (size_t k = 1; k < pop->n_state_vars; ++k)
+            std::fill(pop->extra_states[k - 1].begin(), pop->extra_states[k - 1].end(), pop->neuron_class->get_init_state(k));
+        pop->batch_targets.clear();
+        pop->batch_times.clear();
+        pop->batch_charges.clear();
+        pop->batch_flush_time = INF;
+    }
+    std::fill(neuron_last_spikes_.begin(), neuron_last_spikes_.end(), -INF);
+    std::fill(neuron_last_updates_.begin(), neuron_last_updates_.end(), 0.0);
+    std::fill(neuron_predicted_spikes_.begin(), neuron_predicted_spikes_.end(), INF);
+    pending_batches_ = 0;
+
+    for (auto& gen : generators_) gen->reset();
+    for (auto& rule : stdp_rules_) rule->reset_traces();
+    // The queue is empty - predictions and readings are armed again by the next run
+    armed_ = false;
+    readings_armed_ = false;
+    next_reading_ = std::numeric_limits<double>::quiet_NaN();
+    reset_monitors();
+}
+
+template <class Weight>
+void BasicNeuralNetwork<Weight>::set_num_exec_threads(size_t n) {
     num_exec_threads_ = n;
     omp_set_num_threads(num_exec_threads_);
 }
 
-size_t NeuralNetwork::get_num_exec_threads() const {
+template <class Weight>
+size_t BasicNeuralNetwork<Weight>::get_num_exec_threads() const {
     return num_exec_threads_;
-}
\ No newline at end of file
+}
+
+template class BasicNeuralNetwork<float>;
+template class BasicNeuralNetwork<double>;
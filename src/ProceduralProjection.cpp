@@ -0,0 +1,88 @@
+#include "ProceduralProjection.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+ProceduralProjection::ProceduralProjection(size_t pre_begin, size_t n_pre, size_t post_begin, size_t n_post,
+                                           Connectivity connectivity, double p_or_k,
+                                           double w_min, double w_max, double d_min, double d_max,
+                                           uint64_t seed, bool allow_autapses)
+    : Projection(pre_begin, n_pre, post_begin, n_post),
+      connectivity_(connectivity),
+      p_or_k_(p_or_k),
+      w_min_(w_min),
+      w_max_(w_max),
+      d_min_(d_min),
+      d_max_(d_max),
+      rng_(seed),
+      allow_autapses_(allow_autapses) {
+    if (w_min > w_max) throw std::invalid_argument("ProceduralProjection: w_min must not exceed w_max");
+    if (d_min < 0.0) throw std::invalid_argument("ProceduralProjection: delays must be non-negative");
+    if (d_min > d_max) throw std::invalid_argument("ProceduralProjection: d_min must not exceed d_max");
+    if (connectivity == Connectivity::FixedProbability && (p_or_k < 0.0 || p_or_k > 1.0))
+        throw std::invalid_argument("ProceduralProjection: probability must be in [0, 1]");
+    if (connectivity == Connectivity::FixedOutDegree) {
+        if (p_or_k < 0.0) throw std::invalid_argument("ProceduralProjection: out-degree must be non-negative");
+        if (p_or_k != std::floor(p_or_k)) throw std::invalid_argument("ProceduralProjection: out-degree must be an integer");
+        // A source inside the target range cannot connect to itself without autapses
+        const bool overlap = n_pre > 0 && n_post > 0 && pre_begin < post_begin + n_post && post_begin < pre_begin + n_pre;
+        if (static_cast<size_t>(p_or_k) + (!allow_autapses && overlap) > n_post)
+            throw std::invalid_argument("ProceduralProjection: out-degree exceeds the number of targets");
+    }
+}
+
+void ProceduralProjection::generate(size_t neuron_id, std::vector<Synapse>& out) const {
+    uint64_t counter = 0;
+    auto emit = [&](size_t j) {
+        size_t dst = post_begin_ + j;
+        double w = w_min_ + (w_max_ - w_min_) * rng_.uniform(neuron_id, counter++);
+        double d = d_min_ + (d_max_ - d_min_) * rng_.uniform(neuron_id, counter++);
+        if (allow_autapses_ || dst != neuron_id) out.emplace_back(neuron_id, dst, w, d);
+    };
+
+    if (connectivity_ == Connectivity::FixedProbability) {
+        const double p = p_or_k_;
+        if (p <= 0.0) return;
+        if (p >= 1.0) {
+            for (size_t j = 0; j < n_post_; ++j) emit(j);
+            return;
+        }
+        // Geometric skipping: the gap between consecutive targets is geometrically distributed
+        const double inv_log_q = 1.0 / std::log1p(-p);
+        double j = -1.0;
+        while (true) {
+            j += 1.0 + std::floor(std::log(rng_.uniform(neuron_id, counter++)) * inv_log_q);
+            if (j >= static_cast<double>(n_post_)) break;
+            emit(static_cast<size_t>(j));
+        }
+    } else {
+        // Floyd's algorithm: k distinct offsets of [0, m), kept sorted in the tail of out.
+        // Without autapses the source itself is left out of the range and the offsets above it shift up.
+        const size_t k = static_cast<size_t>(p_or_k_);
+        const size_t self = allow_autapses_ || neuron_id - post_begin_ >= n_post_ ? n_post_ : neuron_id - post_begin_;
+        const size_t m = self < n_post_ ? n_post_ - 1 : n_post_;
+        const size_t base = out.size();
+        auto by_offset = [](const Synapse& syn, size_t offset) { return syn.dst_id < offset; };
+        for (size_t j = m - k; j < m; ++j) {
+            size_t t = std::min(static_cast<size_t>(rng_.uniform(neuron_id, counter++) * (j + 1)), j);
+            auto it = std::lower_bound(out.begin() + base, out.end(), t, by_offset);
+            // Every offset drawn so far is below j, so j goes last
+            if (it != out.end() && it->dst_id == t) {
+                t = j;
+                it = out.end();
+            }
+            out.insert(it, Synapse(neuron_id, t));
+        }
+        for (size_t r = base; r < out.size(); ++r) {
+            Synapse& syn = out[r];
+            syn.dst_id = post_begin_ + syn.dst_id + (syn.dst_id >= self);
+            syn.weight = w_min_ + (w_max_ - w_min_) * rng_.uniform(neuron_id, counter++);
+            syn.delay = d_min_ + (d_max_ - d_min_) * rng_.uniform(neuron_id, counter++);
+        }
+    }
+}
+
+void ProceduralProjection::scale_weights(double factor) {
+    w_min_ *= factor;
+    w_max_ *= factor;
+}
@@ -0,0 +1,100 @@
+#include "STDPRule.h"
+#include <cmath>
+#include <algorithm>
+#include <limits>
+
+STDPRule::STDPRule(size_t pre_begin, size_t n_pre, size_t post_begin, size_t n_post,
+                   double tau_plus, double tau_minus, double A2_plus, double A2_minus, double w_min, double w_max)
+    : pre_begin_(pre_begin),
+      n_pre_(n_pre),
+      post_begin_(post_begin),
+      n_post_(n_post),
+      tau_plus_(tau_plus),
+      tau_minus_(tau_minus),
+      tau_x_(1.0),
+      tau_y_(1.0),
+      A2_plus_(A2_plus),
+      A2_minus_(A2_minus),
+      A3_plus_(0.0),
+      A3_minus_(0.0),
+      w_min_(w_min),
+      w_max_(w_max) {
+    reset_traces();
+}
+
+void STDPRule::set_triplet(double tau_x, double tau_y, double A3_plus, double A3_minus) {
+    tau_x_ = tau_x;
+    tau_y_ = tau_y;
+    A3_plus_ = A3_plus;
+    A3_minus_ = A3_minus;
+}
+
+void STDPRule::reset_traces() {
+    const double never = -std::numeric_limits<double>::infinity();
+    r1_.assign(n_pre_, 0.0);
+    r2_.assign(n_pre_, 0.0);
+    pre_last_.assign(n_pre_, never);
+    o1_.assign(n_post_, 0.0);
+    o2_.assign(n_post_, 0.0);
+    post_last_.assign(n_post_, never);
+}
+
+void STDPRule::decay_pre(size_t i, double t) {
+    double dt = t - pre_last_[i];
+    if (dt <= 0.0) return;
+    r1_[i] *= std::exp(-dt / tau_plus_);
+    r2_[i] *= std::exp(-dt / tau_x_);
+    pre_last_[i] = t;
+}
+
+void STDPRule::decay_post(size_t j, double t) {
+    double dt = t - post_last_[j];
+    if (dt <= 0.0) return;
+    o1_[j] *= std::exp(-dt / tau_minus_);
+    o2_[j] *= std::exp(-dt / tau_y_);
+    post_last_[j] = t;
+}
+
+template <class Weight>
+void STDPRule::on_pre_spike(double t, size_t neuron_id, BasicSynapseMatrix<Weight>& synapses) {
+    size_t i = neuron_id - pre_begin_;
+    decay_pre(i, t);
+
+    // Depression of the outgoing synapses, using the post traces just before the spike
+    const double a_minus = A2_minus_ + A3_minus_ * r2_[i];
+    for (size_t s = synapses.row_ptr[neuron_id]; s < synapses.row_ptr[neuron_id + 1]; ++s) {
+        size_t dst = synapses.dst[s];
+        if (!is_post(dst)) continue;
+        size_t j = dst - post_begin_;
+        decay_post(j, t);
+        synapses.weight[s] = static_cast<Weight>(std::max(w_min_, synapses.weight[s] - o1_[j] * a_minus));
+    }
+
+    r1_[i] += 1.0;
+    r2_[i] += 1.0;
+}
+
+template <class Weight>
+void STDPRule::on_post_spike(double t, size_t neuron_id, BasicSynapseMatrix<Weight>& synapses) {
+    size_t j = neuron_id - post_begin_;
+    decay_post(j, t);
+
+    // Potentiation of the incoming synapses through the reverse index
+    const double a_plus = A2_plus_ + A3_plus_ * o2_[j];
+    for (size_t k = synapses.in_ptr[neuron_id]; k < synapses.in_ptr[neuron_id + 1]; ++k) {
+        size_t s = synapses.in_syn[k];
+        size_t src = synapses.src[s];
+        if (!is_pre(src)) continue;
+        size_t i = src - pre_begin_;
+        decay_pre(i, t);
+        synapses.weight[s] = static_cast<Weight>(std::min(w_max_, synapses.weight[s] + r1_[i] * a_plus));
+    }
+
+    o1_[j] += 1.0;
+    o2_[j] += 1.0;
+}
+
+template void STDPRule::on_pre_spike(double, size_t, BasicSynapseMatrix<float>&);
+template void STDPRule::on_pre_spike(double, size_t, BasicSynapseMatrix<double>&);
+template void STDPRule::on_post_spike(double, size_t, BasicSynapseMatrix<float>&);
+template void STDPRule::on_post_spike(double, size_t, BasicSynapseMatrix<double>&);
@@ -0,0 +1,71 @@
+#include "SpikeCountMonitor.h"
+#include <algorithm>
+#include <cmath>
+
+SpikeCountMonitor::SpikeCountMonitor(double window)
+    : window_(window),
+      started_(false),
+      start_time_(0.0),
+      end_time_(0.0),
+      window_end_(0.0) {}
+
+void SpikeCountMonitor::resize(size_t n_neurons) {
+    if (counts.size() == n_neurons) return;
+    counts.resize(n_neurons, 0);
+    if (window_ > 0.0) {
+        window_counts.resize(n_neurons, 0);
+        last_window_counts.resize(n_neurons, 0);
+    }
+}
+
+void SpikeCountMonitor::on_run_start(double time) {
+    if (started_) return;
+    start_time_ = time;
+    end_time_ = time;
+    window_end_ = time + window_;
+    started_ = true;
+}
+
+void SpikeCountMonitor::on_run_end(double time) {
+    end_time_ = time;
+    if (window_ > 0.0 && time >= window_end_) roll(time);
+}
+
+void SpikeCountMonitor::roll(double time) {
+    // Number of window boundaries crossed since the current window started
+    double crossed = std::floor((time - window_end_) / window_) + 1.0;
+    // Copy rather than swap so that NumPy views keep pointing at the same buffers
+    if (crossed == 1.0)
+        std::copy(window_counts.begin(), window_counts.end(), last_window_counts.begin());
+    else // the last completed window saw no spikes
+        std::fill(last_window_counts.begin(), last_window_counts.end(), 0);
+    std::fill(window_counts.begin(), window_counts.end(), 0);
+    window_end_ += crossed * window_;
+}
+
+void SpikeCountMonitor::reset_counts() {
+    std::fill(counts.begin(), counts.end(), 0);
+    std::fill(window_counts.begin(), window_counts.end(), 0);
+    std::fill(last_window_counts.begin(), last_window_counts.end(), 0);
+    started_ = false;
+}
+
+std::vector<double> SpikeCountMonitor::get_rates() const {
+    std::vector<double> rates(counts.size(), 0.0);
+    double duration = end_time_ - start_time_;
+    if (duration <= 0.0) return rates;
+    for (size_t i = 0; i < counts.size(); ++i)
+        rates[i] = counts[i] / duration;
+    return rates;
+}
+
+std::vector<double> SpikeCountMonitor::get_window_rates() const {
+    std::vector<double> rates(last_window_counts.size(), 0.0);
+    for (size_t i = 0; i < last_window_counts.size(); ++i)
+        rates[i] = last_window_counts[i] / window_;
+    return rates;
+}
+
+double SpikeCountMonitor::get_window() const {
+    return window_;
+}
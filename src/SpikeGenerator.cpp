@@ -0,0 +1,121 @@
+#include "SpikeGenerator.h"
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <algorithm>
+
+SpikeGenerator::SpikeGenerator(size_t n_sources, Mode mode, uint64_t seed)
+    : n_sources_(n_sources),
+      mode_(mode),
+      rng_(seed),
+      armed_(false),
+      rates_(n_sources, 0.0),
+      max_rates_(n_sources, 0.0),
+      bin_width_(0.0),
+      n_bins_(0),
+      origin_(0.0),
+      counters_(n_sources, 0),
+      pending_times_(n_sources, std::numeric_limits<double>::infinity()) {
+    if (mode_ == Mode::Inhomogeneous) rates_.clear();
+}
+
+void SpikeGenerator::set_rates(const std::vector<double>& rates) {
+    if (mode_ == Mode::Inhomogeneous)
+        throw std::invalid_argument("set_rates: use set_rate_profile for inhomogeneous generators");
+    if (rates.size() != n_sources_)
+        throw std::invalid_argument("set_rates: expected one rate per source");
+    if (std::any_of(rates.begin(), rates.end(), [](double r) { return r < 0.0; }))
+        throw std::invalid_argument("set_rates: rates must be non-negative");
+    rates_ = rates;
+    max_rates_ = rates;
+    armed_ = false;
+}
+
+void SpikeGenerator::set_rate_profile(const std::vector<double>& rates, double bin_width) {
+    if (mode_ != Mode::Inhomogeneous)
+        throw std::invalid_argument("set_rate_profile: generator is not inhomogeneous");
+    if (bin_width <= 0.0 || n_sources_ == 0 || rates.size() % n_sources_ != 0)
+        throw std::invalid_argument("set_rate_profile: expected a (n_bins x n_sources) profile and positive bin width");
+    if (std::any_of(rates.begin(), rates.end(), [](double r) { return r < 0.0; }))
+        throw std::invalid_argument("set_rate_profile: rates must be non-negative");
+    rates_ = rates;
+    bin_width_ = bin_width;
+    n_bins_ = rates.size() / n_sources_;
+    std::fill(max_rates_.begin(), max_rates_.end(), 0.0);
+    for (size_t b = 0; b < n_bins_; ++b)
+        for (size_t i = 0; i < n_sources_; ++i)
+            max_rates_[i] = std::max(max_rates_[i], rates_[b * n_sources_ + i]);
+    armed_ = false;
+}
+
+bool SpikeGenerator::needs_arming() const {
+    return !armed_;
+}
+
+void SpikeGenerator::arm(double t) {
+    origin_ = t;
+    armed_ = true;
+}
+
+void SpikeGenerator::reset() {
+    std::fill(counters_.begin(), counters_.end(), 0);
+    std::fill(pending_times_.begin(), pending_times_.end(), std::numeric_limits<double>::infinity());
+    armed_ = false;
+}
+
+double SpikeGenerator::rate_at(size_t source, double t) const {
+    double bin = std::floor((t - origin_) / bin_width_);
+    if (bin < 0.0 || bin >= static_cast<double>(n_bins_)) return 0.0;
+    return rates_[static_cast<size_t>(bin) * n_sources_ + source];
+}
+
+double SpikeGenerator::next_spike_time(size_t source, double t) {
+    constexpr double INF = std::numeric_limits<double>::infinity();
+    const double max_rate = max_rates_[source];
+    double next = INF;
+
+    if (max_rate > 0.0) {
+        switch (mode_) {
+        case Mode::Poisson:
+            next = t + rng_.exponential(source, counters_[source]++, max_rate);
+            break;
+        case Mode::Regular: {
+            // Spikes lie on the grid origin + k/rate
+            double period = 1.0 / max_rate;
+            double k = std::floor((t - origin_) / period) + 1.0;
+            next = origin_ + k * period;
+            if (next <= t) next += period;
+            break;
+        }
+        case Mode::Inhomogeneous: {
+            // Thinning: candidates at the maximum rate, accepted with probability rate(t) / max_rate
+            const double end = origin_ + n_bins_ * bin_width_;
+            double candidate = std::max(t, origin_);
+            while (true) {
+                candidate += rng_.exponential(source, counters_[source]++, max_rate);
+                if (candidate >= end) break;
+                if (rng_.uniform(source, counters_[source]++) * max_rate < rate_at(source, candidate)) {
+                    next = candidate;
+                    break;
+                }
+            }
+            break;
+        }
+        }
+    }
+
+    pending_times_[source] = next;
+    return next;
+}
+
+double SpikeGenerator::pending_spike_time(size_t source) const {
+    return pending_times_[source];
+}
+
+size_t SpikeGenerator::size() const {
+    return n_sources_;
+}
+
+SpikeGenerator::Mode SpikeGenerator::get_mode() const {
+    return mode_;
+}
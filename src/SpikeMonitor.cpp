@@ -6,4 +6,8 @@ void SpikeMonitor::on_spike(double time, size_t neuron_id) {
 
 void SpikeMonitor::reset_spikes() {
     this->spike_list.clear();
-}
\ No newline at end of file
+}
+
+void SpikeMonitor::reserve(size_t n_spikes) {
+    this->spike_list.reserve(n_spikes);
+}
@@ -1,13 +1,36 @@
 #include "StateMonitor.h"
+#include <algorithm>
 
 void StateMonitor::reset_recording() {
+    for (auto& record : this->state_vector_list)
+        this->spare_vectors_.push_back(std::move(record.second));
     this->state_vector_list.clear();
 }
 
-void StateMonitor::on_read(double time, std::vector<double> state_vector) {
-    this->state_vector_list.push_back({time, state_vector});
+void StateMonitor::reserve(size_t n_reads, size_t n_states) {
+    // Geometric growth - short runs repeated many times must not reallocate the list on every call
+    auto grow = [](auto& list, size_t needed) {
+        if (needed > list.capacity()) list.reserve(std::max(needed, 2 * list.capacity()));
+    };
+    grow(this->state_vector_list, this->state_vector_list.size() + n_reads);
+    while (this->spare_vectors_.size() < n_reads) {
+        this->spare_vectors_.emplace_back();
+        this->spare_vectors_.back().reserve(n_states);
+    }
+    // reset_recording moves every recorded vector back to the pool
+    grow(this->spare_vectors_, this->spare_vectors_.size() + this->state_vector_list.capacity());
+}
+
+void StateMonitor::on_read(double time, const std::vector<double>& state_vector) {
+    std::vector<double> record;
+    if (!this->spare_vectors_.empty()) {
+        record = std::move(this->spare_vectors_.back());
+        this->spare_vectors_.pop_back();
+    }
+    record.assign(state_vector.begin(), state_vector.end());
+    this->state_vector_list.emplace_back(time, std::move(record));
 }
 
 double StateMonitor::get_reading_interval() {
     return this->reading_interval_;
-}
\ No newline at end of file
+}
@@ -0,0 +1,114 @@
+#include "SynapseMatrix.h"
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+template <class Weight>
+void BasicSynapseMatrix<Weight>::append(std::vector<std::vector<Synapse>>& staged) {
+    size_t n_rows = staged.size();
+    size_t n_old_rows = num_rows();
+    size_t n_new = 0;
+    for (const auto& row : staged) n_new += row.size();
+    if (size() + n_new > std::numeric_limits<Index>::max() || n_rows > std::numeric_limits<Index>::max())
+        throw std::length_error("SynapseMatrix: too many synapses or neurons for the index type");
+
+    std::vector<Index> new_row_ptr(n_rows + 1, 0);
+    for (size_t i = 0; i < n_rows; ++i) {
+        size_t old_count = i < n_old_rows ? row_ptr[i + 1] - row_ptr[i] : 0;
+        new_row_ptr[i + 1] = static_cast<Index>(new_row_ptr[i] + old_count + staged[i].size());
+    }
+
+    std::vector<Index> new_dst(size() + n_new);
+    std::vector<Weight> new_weight(size() + n_new);
+    std::vector<double> new_delay(size() + n_new);
+    // Scratch for rows that need sorting
+    std::vector<size_t> order;
+    std::vector<Index> row_dst;
+    std::vector<Weight> row_weight;
+    std::vector<double> row_delay;
+    for (size_t i = 0; i < n_rows; ++i) {
+        const size_t begin = new_row_ptr[i];
+        size_t k = begin;
+        // Existing synapses keep their relative order, staged ones follow
+        if (i < n_old_rows) {
+            for (size_t s = row_ptr[i]; s < row_ptr[i + 1]; ++s, ++k) {
+                new_dst[k] = dst[s];
+                new_weight[k] = weight[s];
+                new_delay[k] = delay[s];
+            }
+        }
+        for (const auto& syn : staged[i]) {
+            new_dst[k] = static_cast<Index>(syn.dst_id);
+            new_weight[k] = static_cast<Weight>(syn.weight);
+            new_delay[k] = syn.delay;
+            ++k;
+        }
+        staged[i].clear();
+        staged[i].shrink_to_fit();
+
+        // Stable sort of the row by delay - equal delays end up contiguous
+        if (std::is_sorted(new_delay.begin() + begin, new_delay.begin() + k)) continue;
+        order.resize(k - begin);
+        std::iota(order.begin(), order.end(), begin);
+        std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return new_delay[a] < new_delay[b]; });
+        row_dst.resize(order.size());
+        row_weight.resize(order.size());
+        row_delay.resize(order.size());
+        for (size_t j = 0; j < order.size(); ++j) {
+            row_dst[j] = new_dst[order[j]];
+            row_weight[j] = new_weight[order[j]];
+            row_delay[j] = new_delay[order[j]];
+        }
+        std::copy(row_dst.begin(), row_dst.end(), new_dst.begin() + begin);
+        std::copy(row_weight.begin(), row_weight.end(), new_weight.begin() + begin);
+        std::copy(row_delay.begin(), row_delay.end(), new_delay.begin() + begin);
+    }
+
+    row_ptr.swap(new_row_ptr);
+    dst.swap(new_dst);
+    weight.swap(new_weight);
+    delay.swap(new_delay);
+
+    // Synapse ids changed
+    in_ptr.clear();
+    in_syn.clear();
+    src.clear();
+    build_delay_groups();
+}
+
+template <class Weight>
+void BasicSynapseMatrix<Weight>::build_delay_groups() {
+    size_t n = num_rows();
+    row_group.assign(n + 1, 0);
+    group_ptr.clear();
+    group_ptr.reserve(n + 1);
+    for (size_t i = 0; i < n; ++i) {
+        row_group[i] = group_ptr.size();
+        for (size_t s = row_ptr[i]; s < row_ptr[i + 1]; ++s)
+            if (s == row_ptr[i] || delay[s] != delay[s - 1]) group_ptr.push_back(s);
+    }
+    row_group[n] = group_ptr.size();
+    group_ptr.push_back(size());
+}
+
+template <class Weight>
+void BasicSynapseMatrix<Weight>::build_reverse_index() {
+    size_t n = num_rows();
+    in_ptr.assign(n + 1, 0);
+    for (size_t s = 0; s < size(); ++s) ++in_ptr[dst[s] + 1];
+    for (size_t i = 0; i < n; ++i) in_ptr[i + 1] += in_ptr[i];
+
+    in_syn.resize(size());
+    src.resize(size());
+    std::vector<size_t> fill(in_ptr.begin(), in_ptr.end() - 1);
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t s = row_ptr[i]; s < row_ptr[i + 1]; ++s) {
+            in_syn[fill[dst[s]]++] = s;
+            src[s] = i;
+        }
+    }
+}
+
+template class BasicSynapseMatrix<float>;
+template class BasicSynapseMatrix<double>;
@@ -1,15 +1,199 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>       // For std::vector
 #include <pybind11/numpy.h>     // For NumPy arrays if needed
+#include <algorithm>
 #include "Neuron.h"
 #include "LIFNeuron.h"
 #include "InputNeuron.h"
+#include "ExpCurrentLIFNeuron.h"
+#include "AdExNeuron.h"
+#include "IzhikevichNeuron.h"
+#include "BatchedNeuron.h"
+#include "CompiledNeuron.h"
 #include "SpikeMonitor.h"
+#include "FeatureMonitor.h"
+#include "SpikeCountMonitor.h"
+#include "SpikeGenerator.h"
 #include "Synapse.h"
+#include "STDPRule.h"
+#include "ProceduralProjection.h"
+#include "ConvProjection.h"
+#include "CompressedProjection.h"
+#include "Connectivity.h"
 #include "NeuralNetwork.h"
+#ifdef SNNBLAZE_WITH_MPI
+#include "DistributedNetwork.h"
+#include <cstdlib>
+#endif
 
 namespace py = pybind11;
 
+// NumPy view over engine memory - no copy, valid for the duration of the call
+template <typename T>
+static py::array_t<T> view(const T* ptr, size_t n) {
+    return py::array_t<T>(n, ptr, py::none());
+}
+
+// Trampoline class for Python overrides - kept out of the core headers, which do not depend on pybind11
+class PyNeuron : public Neuron {
+public:
+    using Neuron::Neuron;
+
+    void decay(double t, double* state, double* last_spike, double* last_update, size_t n) override {
+        PYBIND11_OVERRIDE_PURE(
+            void,
+            Neuron,
+            decay,
+            t, state, last_spike, last_update, n
+        );
+    }
+
+    bool receive(double t, double charge, double* state, double* last_spike, double* last_update) override {
+        PYBIND11_OVERRIDE_PURE(
+            bool,
+            Neuron,
+            receive,
+            t, charge, state, last_spike, last_update
+        );
+    }
+
+    double get_init_value() override {
+        PYBIND11_OVERRIDE_PURE(
+            double,
+            Neuron,
+            get_init_value
+        );
+    }
+};
+
+// Trampoline for batched Python models: one interpreter call per batch, arrays passed as views.
+// Python side: decay(t, state, last_spike, last_update) and
+// process_batch(targets, times, charges, state, last_spike, last_update) -> boolean fire mask
+class PyBatchedNeuron : public BatchedNeuron {
+public:
+    using BatchedNeuron::BatchedNeuron;
+
+    double get_init_value() override {
+        PYBIND11_OVERRIDE_PURE(double, BatchedNeuron, get_init_value);
+    }
+
+    void decay(double t, double* state, double* last_spike, double* last_update, size_t n) override {
+        py::gil_scoped_acquire gil;
+        py::function override = py::get_override(static_cast<const BatchedNeuron*>(this), "decay");
+        if (!override) throw std::runtime_error("BatchedNeuron subclasses must implement decay");
+        override(t, view(state, n), view(last_spike, n), view(last_update, n));
+    }
+
+    void process_batch(size_t n, const size_t* targets, const double* times, const double* charges,
+                       double* state, double* last_spike, double* last_update, size_t n_neurons,
+                       uint8_t* fired) override {
+        py::gil_scoped_acquire gil;
+        py::function override = py::get_override(static_cast<const BatchedNeuron*>(this), "process_batch");
+        if (!override) throw std::runtime_error("BatchedNeuron subclasses must implement process_batch");
+        py::object result = override(view(targets, n), view(times, n), view(charges, n),
+                                     view(state, n_neurons), view(last_spike, n_neurons), view(last_update, n_neurons));
+        if (result.is_none()) return;   // no spikes
+        auto mask = py::array_t<bool, py::array::c_style | py::array::forcecast>::ensure(result);
+        if (!mask || static_cast<size_t>(mask.size()) != n)
+            throw std::runtime_error("process_batch must return one boolean per event");
+        const bool* m = mask.data();
+        for (size_t i = 0; i < n; ++i) fired[i] = m[i];
+    }
+};
+
+// Engine bindings, instantiated for every weight precision
+template <class Weight>
+static void bind_network(py::module_& m, const char* name) {
+    using Network = BasicNeuralNetwork<Weight>;
+    py::class_<Network>(m, name)
+        .def(py::init<>())
+        .def("add_neuron_population", &Network::add_neuron_population,
+             py::arg("size"), py::arg("neuron_type"))
+        .def("add_input_population", &Network::add_input_population,
+             py::arg("generator"))
+        .def("add_synapse", &Network::add_synapse,
+             py::arg("synapse"))
+        .def("get_synapses", &Network::get_synapses)
+        .def("add_stdp_rule", &Network::add_stdp_rule, py::arg("rule"))
+        .def("add_projection", &Network::add_projection, py::arg("projection"))
+        .def("compress_synapses", &Network::compress_synapses, py::arg("pre_pop"), py::arg("post_pop"),
+             py::arg("bits") = CompressedProjection::WeightBits::Int8, py::arg("weight_scale") = 0.0)
+        // Views over the CSR weight/delay arrays - weight writes go straight to the engine, delays are read-only
+        // (set_delays regroups the synapses). Invalidated when newly added synapses are built into the storage
+        .def("num_synapses", &Network::num_synapses)
+        .def("get_weights", [](py::object self) {
+            auto& w = self.cast<Network&>().get_weights();
+            return py::array_t<Weight>(w.size(), w.data(), self);
+        })
+        .def("get_delays", [](py::object self) {
+            const auto& d = self.cast<Network&>().get_delays();
+            py::array_t<double> view(d.size(), d.data(), self);
+            view.attr("setflags")(py::arg("write") = false);
+            return view;
+        })
+        .def("set_weights", [](Network &self, py::array_t<Weight, py::array::c_style | py::array::forcecast> weights) {
+            auto& w = self.get_weights();
+            if (static_cast<size_t>(weights.size()) != w.size()) throw std::invalid_argument("set_weights: one weight per synapse is required");
+            std::copy(weights.data(), weights.data() + weights.size(), w.begin());
+        }, py::arg("weights"))
+        .def("set_delays", [](Network &self, py::array_t<double, py::array::c_style | py::array::forcecast> delays) {
+            self.set_delays(std::vector<double>(delays.data(), delays.data() + delays.size()));
+        }, py::arg("delays"))
+        .def("scale_weights", &Network::scale_weights, py::arg("pre_pop"), py::arg("post_pop"), py::arg("factor"))
+        .def("connect_random", &Network::connect_random,
+             py::arg("pre_pop"), py::arg("post_pop"), py::arg("p"), py::arg("weight"), py::arg("delay") = Distribution(0.0),
+             py::arg("seed") = 0, py::arg("allow_autapses") = true)
+        .def("connect_fixed_outdegree", &Network::connect_fixed_outdegree,
+             py::arg("pre_pop"), py::arg("post_pop"), py::arg("k"), py::arg("weight"), py::arg("delay") = Distribution(0.0),
+             py::arg("seed") = 0, py::arg("allow_autapses") = true)
+        .def("connect_fixed_indegree", &Network::connect_fixed_indegree,
+             py::arg("pre_pop"), py::arg("post_pop"), py::arg("k"), py::arg("weight"), py::arg("delay") = Distribution(0.0),
+             py::arg("seed") = 0, py::arg("allow_autapses") = true)
+        .def("connect_distance", &Network::connect_distance,
+             py::arg("pre_pop"), py::arg("post_pop"), py::arg("pre_positions"), py::arg("post_positions"),
+             py::arg("C"), py::arg("lambda_"), py::arg("weight"), py::arg("delay") = Distribution(0.0),
+             py::arg("seed") = 0, py::arg("allow_autapses") = true)
+        .def("connect_small_world", &Network::connect_small_world,
+             py::arg("pop"), py::arg("k"), py::arg("beta"), py::arg("weight"), py::arg("delay") = Distribution(0.0),
+             py::arg("seed") = 0)
+        .def("schedule_spike_event", &Network::schedule_spike_event,
+             py::arg("time"), py::arg("neuronIndex"), py::arg("weight"))
+        .def("schedule_absolute_spike_event", &Network::schedule_absolute_spike_event,
+             py::arg("time"), py::arg("neuron_index"), py::arg("weight"))
+        .def("schedule_spike_events", [](Network &self, py::array_t<double, py::array::c_style | py::array::forcecast> times,
+                                          py::array_t<size_t, py::array::c_style | py::array::forcecast> neuron_indices,
+                                          py::array_t<double, py::array::c_style | py::array::forcecast> weights) {
+            self.schedule_spike_events(std::vector<double>(times.data(), times.data() + times.size()),
+                                       std::vector<size_t>(neuron_indices.data(), neuron_indices.data() + neuron_indices.size()),
+                                       std::vector<double>(weights.data(), weights.data() + weights.size()));
+        }, py::arg("times"), py::arg("neuron_indices"), py::arg("weights"))
+        .def("reserve_events", &Network::reserve_events, py::arg("n"))
+        .def("set_max_delay_lanes", &Network::set_max_delay_lanes, py::arg("k"))
+        .def("set_spike_monitor", &Network::set_spike_monitor, py::arg("monitor"))
+        .def("set_state_monitor", &Network::set_state_monitor, py::arg("monitor"))
+        .def("set_feature_monitor", &Network::set_feature_monitor, py::arg("monitor"))
+        .def("set_spike_count_monitor", &Network::set_spike_count_monitor, py::arg("monitor"))
+        .def("run", &Network::run, py::arg("T"))
+        .def("run_until", &Network::run_until, py::arg("t"))
+        .def("step", &Network::step)
+        .def("set_step", &Network::set_step, py::arg("dt"))
+        .def("get_step", &Network::get_step)
+        .def("reset_monitors", &Network::reset_monitors)
+        .def("reset", &Network::reset)
+        .def("size", &Network::size)
+        .def("get_population_state", &Network::get_population_state, py::arg("population"), py::arg("var") = 0)
+        .def("set_population_param", [](Network &self, size_t population, const std::string& name,
+                                        py::array_t<double, py::array::c_style | py::array::forcecast> values) {
+            self.set_population_param(population, name, std::vector<double>(values.data(), values.data() + values.size()));
+        }, py::arg("population"), py::arg("name"), py::arg("values"))
+        .def("get_population_param", &Network::get_population_param, py::arg("population"), py::arg("name"))
+        .def("optimize_layout", &Network::optimize_layout)
+        .def("get_layout", &Network::get_layout)
+        .def("set_num_exec_threads", &Network::set_num_exec_threads, py::arg("n"))
+        .def("get_num_exec_threads", &Network::get_num_exec_threads)
+        .def_readonly("sim_time", &Network::sim_time);
+}
+
 PYBIND11_MODULE(pysnnblaze, m) {
     py::class_<Neuron, PyNeuron, std::shared_ptr<Neuron>>(m, "Neuron")
         .def("decay", [](Neuron &self, double t, py::array_t<double> state, py::array_t<double> lastSpike, py::array_t<double> lastUpdate, size_t n) {
@@ -25,17 +209,43 @@ PYBIND11_MODULE(pysnnblaze, m) {
             auto lastUpdate_ptr = static_cast<double*>(lastUpdate.request().ptr);
             self.receive(t, charge, state_ptr, lastSpike_ptr, lastUpdate_ptr);
         })
-        .def("get_init_value", &Neuron::get_init_value);
+        .def("get_init_value", &Neuron::get_init_value)
+        .def("get_num_state_vars", &Neuron::get_num_state_vars)
+        .def("get_param_names", &Neuron::get_param_names);
+
+    py::class_<BatchedNeuron, Neuron, PyBatchedNeuron, std::shared_ptr<BatchedNeuron>>(m, "BatchedNeuron")
+        .def(py::init<double>(), py::arg("window") = 0.0)
+        .def_readwrite("window", &BatchedNeuron::window_);
+
+    py::class_<ModelDefinition>(m, "ModelDefinition")
+        .def(py::init<>())
+        .def_readwrite("state_vars", &ModelDefinition::state_vars)
+        .def_readwrite("init_values", &ModelDefinition::init_values)
+        .def_readwrite("params", &ModelDefinition::params)
+        .def_readwrite("decay", &ModelDefinition::decay)
+        .def_readwrite("input", &ModelDefinition::input)
+        .def_readwrite("threshold", &ModelDefinition::threshold)
+        .def_readwrite("reset", &ModelDefinition::reset)
+        .def_readwrite("refractory", &ModelDefinition::refractory);
+
+    py::class_<CompiledNeuron, Neuron, std::shared_ptr<CompiledNeuron>>(m, "CompiledNeuron")
+        .def_readonly("definition", &CompiledNeuron::definition_)
+        .def_readonly("library_path", &CompiledNeuron::library_path_);
+
+    m.def("generate_model_source", &generate_model_source, py::arg("definition"));
+    m.def("compile_model", &compile_model, py::arg("definition"), py::arg("cache_dir") = "");
 
     py::class_<LIFNeuron, Neuron, std::shared_ptr<LIFNeuron>>(m, "LIFNeuron")
-        .def(py::init<double, double, double, double, double, double>(), 
-             py::arg("tau_m"), py::arg("C_m"), py::arg("v_rest"), py::arg("v_reset"), py::arg("v_thresh"), py::arg("refractory"))
+        .def(py::init<double, double, double, double, double, double, double>(), 
+             py::arg("tau_m"), py::arg("C_m"), py::arg("v_rest"), py::arg("v_reset"), py::arg("v_thresh"), py::arg("refractory"),
+             py::arg("i_bias") = 0.0)
         .def_readwrite("C_m", &LIFNeuron::tau_m_)
         .def_readwrite("tau_m", &LIFNeuron::tau_m_)
         .def_readwrite("v_rest", &LIFNeuron::v_rest_)
         .def_readwrite("v_reset", &LIFNeuron::v_reset_)
         .def_readwrite("v_thresh", &LIFNeuron::v_thresh_)
         .def_readwrite("refractory", &LIFNeuron::refractory_)
+        .def_readwrite("i_bias", &LIFNeuron::i_bias_)
         .def("decay", [](LIFNeuron &self, double t, py::array_t<double> state, py::array_t<double> lastSpike, py::array_t<double> lastUpdate, size_t n) {
             auto state_ptr = static_cast<double*>(state.request().ptr);
             auto lastSpike_ptr = static_cast<double*>(lastSpike.request().ptr);
@@ -66,11 +276,64 @@ PYBIND11_MODULE(pysnnblaze, m) {
         })
         .def("get_init_value", &InputNeuron::get_init_value);
     
+    // Multi-state models - kernels run inside the engine over the population state arrays
+    py::class_<ExpCurrentLIFNeuron, Neuron, std::shared_ptr<ExpCurrentLIFNeuron>>(m, "ExpCurrentLIFNeuron")
+        .def(py::init<double, double, double, double, double, double, double>(),
+             py::arg("tau_m"), py::arg("tau_syn"), py::arg("C_m"), py::arg("v_rest"), py::arg("v_reset"), py::arg("v_thresh"), py::arg("refractory"))
+        .def_readwrite("tau_m", &ExpCurrentLIFNeuron::tau_m_)
+        .def_readwrite("tau_syn", &ExpCurrentLIFNeuron::tau_syn_)
+        .def_readwrite("C_m", &ExpCurrentLIFNeuron::C_m_)
+        .def_readwrite("v_rest", &ExpCurrentLIFNeuron::v_rest_)
+        .def_readwrite("v_reset", &ExpCurrentLIFNeuron::v_reset_)
+        .def_readwrite("v_thresh", &ExpCurrentLIFNeuron::v_thresh_)
+        .def_readwrite("refractory", &ExpCurrentLIFNeuron::refractory_);
+
+    py::class_<AdExNeuron, Neuron, std::shared_ptr<AdExNeuron>>(m, "AdExNeuron")
+        .def(py::init<double, double, double, double, double, double, double, double, double, double, double>(),
+             py::arg("C_m") = 281e-12, py::arg("g_L") = 30e-9, py::arg("E_L") = -70.6e-3, py::arg("v_T") = -50.4e-3,
+             py::arg("delta_T") = 2e-3, py::arg("a") = 4e-9, py::arg("tau_w") = 0.144, py::arg("b") = 0.0805e-9,
+             py::arg("v_reset") = -70.6e-3, py::arg("v_peak") = 0.0, py::arg("dt_int") = 1e-4)
+        .def_readwrite("C_m", &AdExNeuron::C_m_)
+        .def_readwrite("g_L", &AdExNeuron::g_L_)
+        .def_readwrite("E_L", &AdExNeuron::E_L_)
+        .def_readwrite("v_T", &AdExNeuron::v_T_)
+        .def_readwrite("delta_T", &AdExNeuron::delta_T_)
+        .def_readwrite("a", &AdExNeuron::a_)
+        .def_readwrite("tau_w", &AdExNeuron::tau_w_)
+        .def_readwrite("b", &AdExNeuron::b_)
+        .def_readwrite("v_reset", &AdExNeuron::v_reset_)
+        .def_readwrite("v_peak", &AdExNeuron::v_peak_)
+        .def_readwrite("dt_int", &AdExNeuron::dt_int_);
+
+    py::class_<IzhikevichNeuron, Neuron, std::shared_ptr<IzhikevichNeuron>>(m, "IzhikevichNeuron")
+        .def(py::init<double, double, double, double, double>(),
+             py::arg("a") = 0.02, py::arg("b") = 0.2, py::arg("c") = -65.0, py::arg("d") = 8.0, py::arg("dt_int") = 1e-4)
+        .def_readwrite("a", &IzhikevichNeuron::a_)
+        .def_readwrite("b", &IzhikevichNeuron::b_)
+        .def_readwrite("c", &IzhikevichNeuron::c_)
+        .def_readwrite("d", &IzhikevichNeuron::d_)
+        .def_readwrite("dt_int", &IzhikevichNeuron::dt_int_);
+
     py::class_<SpikeMonitor, std::shared_ptr<SpikeMonitor>>(m, "SpikeMonitor")
         .def(py::init<>())  // default constructor
         .def("on_spike", &SpikeMonitor::on_spike,
             py::arg("neuron_id"), py::arg("time"))
         .def("reset_spikes", &SpikeMonitor::reset_spikes)
+        .def("reserve", &SpikeMonitor::reserve, py::arg("n_spikes"))
+        // Spikes recorded since the last call as (times, neuron_ids) arrays - cheaper than spike_list between steps
+        .def("take_spikes", [](SpikeMonitor &self) {
+            const size_t n = self.spike_list.size();
+            py::array_t<double> times(n);
+            py::array_t<size_t> ids(n);
+            auto t = times.mutable_unchecked<1>();
+            auto id = ids.mutable_unchecked<1>();
+            for (size_t k = 0; k < n; ++k) {
+                t(k) = self.spike_list[k].first;
+                id(k) = self.spike_list[k].second;
+            }
+            self.reset_spikes();
+            return py::make_tuple(times, ids);
+        })
         .def_readwrite("spike_list", &SpikeMonitor::spike_list,
                     "List of (time, neuron_id) pairs");
 
@@ -78,9 +341,84 @@ PYBIND11_MODULE(pysnnblaze, m) {
         .def(py::init<double>(), py::arg("reading_interval"))
         .def("on_read", &StateMonitor::on_read, py::arg("time"), py::arg("state_vector"))
         .def("reset_recording", &StateMonitor::reset_recording)
+        .def("reserve", &StateMonitor::reserve, py::arg("n_reads"), py::arg("n_states"))
         .def("get_reading_interval", &StateMonitor::get_reading_interval)
         .def_readwrite("state_vector_list", &StateMonitor::state_vector_list);
 
+    py::class_<SpikeCountMonitor, std::shared_ptr<SpikeCountMonitor>>(m, "SpikeCountMonitor")
+        .def(py::init<double>(), py::arg("window") = 0.0)
+        .def("reset_counts", &SpikeCountMonitor::reset_counts)
+        .def("get_rates", &SpikeCountMonitor::get_rates)
+        .def("get_window_rates", &SpikeCountMonitor::get_window_rates)
+        .def("get_window", &SpikeCountMonitor::get_window)
+        // Views over the monitor counters - no copies, sized on the first run
+        .def_property_readonly("counts", [](py::object self) {
+            auto& mon = self.cast<SpikeCountMonitor&>();
+            return py::array_t<uint64_t>(mon.counts.size(), mon.counts.data(), self);
+        })
+        // Same names as the C++ members: the current (incomplete) window and the last completed one
+        .def_property_readonly("window_counts", [](py::object self) {
+            auto& mon = self.cast<SpikeCountMonitor&>();
+            return py::array_t<uint32_t>(mon.window_counts.size(), mon.window_counts.data(), self);
+        })
+        .def_property_readonly("last_window_counts", [](py::object self) {
+            auto& mon = self.cast<SpikeCountMonitor&>();
+            return py::array_t<uint32_t>(mon.last_window_counts.size(), mon.last_window_counts.data(), self);
+        });
+
+    py::class_<FeatureMonitor, std::shared_ptr<FeatureMonitor>>(m, "FeatureMonitor")
+        .def(py::init<size_t, size_t, double, size_t, double>(),
+             py::arg("first_neuron"), py::arg("n_neurons"), py::arg("bin_width"), py::arg("n_bins"), py::arg("tau") = 0.0)
+        .def("reset_recording", &FeatureMonitor::reset_recording)
+        // (n_bins, n_neurons) views over the monitor buffers - no copies, valid while the monitor lives
+        .def_property_readonly("counts", [](py::object self) {
+            auto& mon = self.cast<FeatureMonitor&>();
+            return py::array_t<double>({mon.n_bins_, mon.n_neurons_}, mon.counts.data(), self);
+        })
+        .def_property_readonly("traces", [](py::object self) {
+            auto& mon = self.cast<FeatureMonitor&>();
+            if (mon.traces.empty()) throw std::runtime_error("FeatureMonitor: traces require tau > 0");
+            return py::array_t<double>({mon.n_bins_, mon.n_neurons_}, mon.traces.data(), self);
+        });
+
+    py::class_<SpikeGenerator, std::shared_ptr<SpikeGenerator>> spike_generator(m, "SpikeGenerator");
+    py::enum_<SpikeGenerator::Mode>(spike_generator, "Mode")
+        .value("Poisson", SpikeGenerator::Mode::Poisson)
+        .value("Regular", SpikeGenerator::Mode::Regular)
+        .value("Inhomogeneous", SpikeGenerator::Mode::Inhomogeneous);
+    spike_generator
+        .def(py::init<size_t, SpikeGenerator::Mode, uint64_t>(),
+             py::arg("n_sources"), py::arg("mode") = SpikeGenerator::Mode::Poisson, py::arg("seed") = 0)
+        .def("set_rates", [](SpikeGenerator &self, py::array_t<double, py::array::c_style | py::array::forcecast> rates) {
+            self.set_rates(std::vector<double>(rates.data(), rates.data() + rates.size()));
+        }, py::arg("rates"))
+        .def("set_rate_profile", [](SpikeGenerator &self, py::array_t<double, py::array::c_style | py::array::forcecast> rates, double bin_width) {
+            // Expects shape (n_bins, n_sources)
+            self.set_rate_profile(std::vector<double>(rates.data(), rates.data() + rates.size()), bin_width);
+        }, py::arg("rates"), py::arg("bin_width"))
+        .def("size", &SpikeGenerator::size)
+        .def("get_mode", &SpikeGenerator::get_mode);
+
+    py::class_<Distribution> distribution(m, "Distribution");
+    py::enum_<Distribution::Kind>(distribution, "Kind")
+        .value("Constant", Distribution::Kind::Constant)
+        .value("Uniform", Distribution::Kind::Uniform)
+        .value("Normal", Distribution::Kind::Normal);
+    distribution
+        .def(py::init<double>(), py::arg("value"))
+        .def(py::init<Distribution::Kind, double, double>(), py::arg("kind"), py::arg("a"), py::arg("b"))
+        .def_static("constant", &Distribution::constant, py::arg("value"))
+        .def_static("uniform", &Distribution::uniform, py::arg("low"), py::arg("high"))
+        .def_static("normal", &Distribution::normal, py::arg("mean"), py::arg("std"))
+        .def_readwrite("kind", &Distribution::kind)
+        .def_readwrite("a", &Distribution::a)
+        .def_readwrite("b", &Distribution::b);
+    // Plain numbers are accepted wherever a distribution is expected
+    py::implicitly_convertible<double, Distribution>();
+    py::implicitly_convertible<int, Distribution>();
+
+    m.def("grid_positions", &grid_positions, py::arg("nx"), py::arg("ny"), py::arg("nz"), py::arg("spacing") = 1.0);
+
     py::class_<Synapse>(m, "Synapse")
         .def(py::init<size_t, size_t, double, double>(),
              py::arg("srcId"), py::arg("dstId"), py::arg("weight"), py::arg("delay"))
@@ -89,21 +427,128 @@ PYBIND11_MODULE(pysnnblaze, m) {
         .def_readwrite("weight", &Synapse::weight)
         .def_readwrite("delay", &Synapse::delay);
 
-    // Bind NeuralNetwork
-    py::class_<NeuralNetwork>(m, "NeuralNetwork")
-        .def(py::init<>())
-        .def("add_neuron_population", &NeuralNetwork::add_neuron_population,
-             py::arg("size"), py::arg("neuron_type"))
-        .def("add_synapse", &NeuralNetwork::add_synapse,
-             py::arg("synapse"))
-        .def("schedule_spike_event", &NeuralNetwork::schedule_spike_event,
-             py::arg("time"), py::arg("neuronIndex"), py::arg("weight"))
-        .def("set_spike_monitor", &NeuralNetwork::set_spike_monitor, py::arg("monitor"))
-        .def("set_state_monitor", &NeuralNetwork::set_state_monitor, py::arg("monitor"))
-        .def("run", &NeuralNetwork::run, py::arg("T"))
-        .def("reset_monitors", &NeuralNetwork::reset_monitors)
-        .def("size", &NeuralNetwork::size)
-        .def("set_num_exec_threads", &NeuralNetwork::set_num_exec_threads, py::arg("n"))
-        .def("get_num_exec_threads", &NeuralNetwork::get_num_exec_threads)
-        .def_readonly("sim_time", &NeuralNetwork::sim_time);
+    py::class_<STDPRule, std::shared_ptr<STDPRule>>(m, "STDPRule")
+        .def(py::init<size_t, size_t, size_t, size_t, double, double, double, double, double, double>(),
+             py::arg("pre_begin"), py::arg("n_pre"), py::arg("post_begin"), py::arg("n_post"),
+             py::arg("tau_plus") = 16.8e-3, py::arg("tau_minus") = 33.7e-3, py::arg("A2_plus") = 5e-3, py::arg("A2_minus") = 7e-3,
+             py::arg("w_min") = 0.0, py::arg("w_max") = 1.0)
+        .def("set_triplet", &STDPRule::set_triplet,
+             py::arg("tau_x"), py::arg("tau_y"), py::arg("A3_plus"), py::arg("A3_minus"))
+        .def("reset_traces", &STDPRule::reset_traces)
+        .def_readwrite("tau_plus", &STDPRule::tau_plus_)
+        .def_readwrite("tau_minus", &STDPRule::tau_minus_)
+        .def_readwrite("tau_x", &STDPRule::tau_x_)
+        .def_readwrite("tau_y", &STDPRule::tau_y_)
+        .def_readwrite("A2_plus", &STDPRule::A2_plus_)
+        .def_readwrite("A2_minus", &STDPRule::A2_minus_)
+        .def_readwrite("A3_plus", &STDPRule::A3_plus_)
+        .def_readwrite("A3_minus", &STDPRule::A3_minus_)
+        .def_readwrite("w_min", &STDPRule::w_min_)
+        .def_readwrite("w_max", &STDPRule::w_max_);
+
+    py::class_<Projection, std::shared_ptr<Projection>>(m, "Projection")
+        .def_readonly("pre_begin", &Projection::pre_begin_)
+        .def_readonly("n_pre", &Projection::n_pre_)
+        .def_readonly("post_begin", &Projection::post_begin_)
+        .def_readonly("n_post", &Projection::n_post_)
+        .def("generate", [](const Projection& self, size_t neuron_id) {
+            std::vector<Synapse> out;
+            self.generate(neuron_id, out);
+            return out;
+        }, py::arg("neuron_id"))
+        .def("scale_weights", &Projection::scale_weights, py::arg("factor"));
+
+    py::class_<ProceduralProjection, Projection, std::shared_ptr<ProceduralProjection>> procedural(m, "ProceduralProjection");
+    py::enum_<ProceduralProjection::Connectivity>(procedural, "Connectivity")
+        .value("FixedProbability", ProceduralProjection::Connectivity::FixedProbability)
+        .value("FixedOutDegree", ProceduralProjection::Connectivity::FixedOutDegree);
+    procedural
+        .def(py::init<size_t, size_t, size_t, size_t, ProceduralProjection::Connectivity, double,
+                      double, double, double, double, uint64_t, bool>(),
+             py::arg("pre_begin"), py::arg("n_pre"), py::arg("post_begin"), py::arg("n_post"),
+             py::arg("connectivity"), py::arg("p_or_k"),
+             py::arg("w_min"), py::arg("w_max"), py::arg("d_min") = 0.0, py::arg("d_max") = 0.0,
+             py::arg("seed") = 0, py::arg("allow_autapses") = true)
+        .def_readwrite("w_min", &ProceduralProjection::w_min_)
+        .def_readwrite("w_max", &ProceduralProjection::w_max_)
+        .def_readonly("d_min", &ProceduralProjection::d_min_)
+        .def_readonly("d_max", &ProceduralProjection::d_max_);
+
+    py::class_<ConvProjection, Projection, std::shared_ptr<ConvProjection>>(m, "ConvProjection")
+        .def(py::init([](size_t pre_begin, size_t in_channels, size_t in_height, size_t in_width,
+                         size_t post_begin, size_t out_channels,
+                         py::array_t<double, py::array::c_style | py::array::forcecast> weights,
+                         double delay, size_t stride, size_t padding, bool depthwise) {
+                 // Kernel size taken from the last two axes of the weight array
+                 if (weights.ndim() < 2) throw std::invalid_argument("ConvProjection: weights need kernel axes");
+                 size_t kernel_h = weights.shape(weights.ndim() - 2);
+                 size_t kernel_w = weights.shape(weights.ndim() - 1);
+                 return std::make_shared<ConvProjection>(pre_begin, in_channels, in_height, in_width,
+                                                         post_begin, out_channels, kernel_h, kernel_w,
+                                                         std::vector<double>(weights.data(), weights.data() + weights.size()),
+                                                         delay, stride, padding, depthwise);
+             }),
+             py::arg("pre_begin"), py::arg("in_channels"), py::arg("in_height"), py::arg("in_width"),
+             py::arg("post_begin"), py::arg("out_channels"), py::arg("weights"),
+             py::arg("delay") = 0.0, py::arg("stride") = 1, py::arg("padding") = 0, py::arg("depthwise") = false)
+        .def("out_height", &ConvProjection::out_height)
+        .def("out_width", &ConvProjection::out_width)
+        .def_readwrite("delay", &ConvProjection::delay_);
+
+    py::class_<CompressedProjection, Projection, std::shared_ptr<CompressedProjection>> compressed(m, "CompressedProjection");
+    py::enum_<CompressedProjection::WeightBits>(compressed, "WeightBits")
+        .value("Int8", CompressedProjection::WeightBits::Int8)
+        .value("Int16", CompressedProjection::WeightBits::Int16);
+    compressed
+        .def(py::init<size_t, size_t, size_t, size_t, CompressedProjection::WeightBits, double>(),
+             py::arg("pre_begin"), py::arg("n_pre"), py::arg("post_begin"), py::arg("n_post"),
+             py::arg("bits") = CompressedProjection::WeightBits::Int8, py::arg("weight_scale") = 0.0)
+        // Rows indexed by network source id, e.g. [[Synapse, ...], ...]
+        .def("compress", [](CompressedProjection& self, std::vector<std::vector<Synapse>> rows) {
+            self.compress(rows);
+        }, py::arg("rows"))
+        .def("num_synapses", &CompressedProjection::num_synapses)
+        .def("memory_bytes", &CompressedProjection::memory_bytes)
+        .def_readonly("bits", &CompressedProjection::bits_)
+        .def_readonly("weight_scale", &CompressedProjection::weight_scale_);
+
+    // Bind NeuralNetwork - same API for both weight precisions, NeuralNetworkF32 stores float32 weights
+    bind_network<double>(m, "NeuralNetwork");
+    bind_network<float>(m, "NeuralNetworkF32");
+
+#ifdef SNNBLAZE_WITH_MPI
+    // Initialized on first use when the interpreter was not started through mpi4py
+    py::class_<DistributedNetwork>(m, "DistributedNetwork")
+        .def(py::init([]() {
+            int initialized = 0;
+            MPI_Initialized(&initialized);
+            if (!initialized) {
+                MPI_Init(nullptr, nullptr);
+                std::atexit([]() {
+                    int finalized = 0;
+                    MPI_Finalized(&finalized);
+                    if (!finalized) MPI_Finalize();
+                });
+            }
+            return std::make_unique<DistributedNetwork>(MPI_COMM_WORLD);
+        }))
+        .def("add_neuron_population", &DistributedNetwork::add_neuron_population, py::arg("size"), py::arg("neuron_type"))
+        .def("add_synapse", &DistributedNetwork::add_synapse, py::arg("synapse"))
+        .def("schedule_spike_event", &DistributedNetwork::schedule_spike_event,
+             py::arg("time"), py::arg("neuron_index"), py::arg("weight"))
+        .def("run", &DistributedNetwork::run, py::arg("T"))
+        .def("gather_spikes", &DistributedNetwork::gather_spikes, py::arg("root") = 0)
+        .def("gather_population_state", &DistributedNetwork::gather_population_state,
+             py::arg("population"), py::arg("var") = 0, py::arg("root") = 0)
+        .def("reset_spikes", &DistributedNetwork::reset_spikes)
+        .def("size", &DistributedNetwork::size)
+        .def("owner", &DistributedNetwork::owner, py::arg("neuron_index"))
+        .def("is_local", &DistributedNetwork::is_local, py::arg("neuron_index"))
+        .def("to_local", &DistributedNetwork::to_local, py::arg("neuron_index"))
+        .def("to_global", &DistributedNetwork::to_global, py::arg("local_index"))
+        .def("local", &DistributedNetwork::local, py::return_value_policy::reference_internal)
+        .def_property_readonly("rank", &DistributedNetwork::rank)
+        .def_property_readonly("num_ranks", &DistributedNetwork::num_ranks)
+        .def_property_readonly("sim_time", &DistributedNetwork::sim_time);
+#endif
 }
@@ -0,0 +1,91 @@
+// snnblaze_run: native batch runner - no Python in the loop.
+// Runs every sample of an input spike file on the network described in a network file (see BatchRunner.h
+// for both formats) and writes, per sample, the spike count of every readout neuron:
+//   <sample> <count_0> <count_1> ...
+// or with --spikes one line per readout spike: <sample> <time> <neuron>
+#include "BatchRunner.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+static void usage() {
+    std::fprintf(stderr,
+                 "Usage: snnblaze_run <network> <inputs> --duration <T> [--threads <n>] [--readout <first> <count>]\n"
+                 "                    [--spikes] [--output <file>]\n");
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        usage();
+        return 2;
+    }
+    std::string network_path = argv[1], input_path = argv[2], output_path;
+    double duration = -1.0;
+    size_t n_threads = 0, readout_first = 0, readout_size = 0;
+    bool readout = false, record_spikes = false;
+
+    for (int i = 3; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto value = [&]() -> const char* {
+            if (i + 1 >= argc) {
+                usage();
+                std::exit(2);
+            }
+            return argv[++i];
+        };
+        if (arg == "--duration") duration = std::atof(value());
+        else if (arg == "--threads") n_threads = std::strtoull(value(), nullptr, 10);
+        else if (arg == "--readout") {
+            readout_first = std::strtoull(value(), nullptr, 10);
+            readout_size = std::strtoull(value(), nullptr, 10);
+            readout = true;
+        }
+        else if (arg == "--spikes") record_spikes = true;
+        else if (arg == "--output") output_path = value();
+        else {
+            usage();
+            return 2;
+        }
+    }
+    if (duration < 0.0) {
+        usage();
+        return 2;
+    }
+
+    try {
+        BatchRunner runner(load_network_spec(network_path), duration);
+        if (readout) runner.set_readout(readout_first, readout_size);
+        runner.set_record_spikes(record_spikes);
+        auto samples = load_input_samples(input_path);
+
+        auto start = std::chrono::steady_clock::now();
+        auto results = runner.run(samples, n_threads);
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::ofstream file;
+        if (!output_path.empty()) {
+            file.open(output_path);
+            if (!file) throw std::runtime_error("Cannot open output file " + output_path);
+        }
+        std::ostream& out = output_path.empty() ? std::cout : file;
+        out << std::setprecision(17);
+        for (size_t s = 0; s < results.size(); ++s) {
+            if (record_spikes) {
+                for (const auto& spike : results[s].spikes) out << s << ' ' << spike.first << ' ' << spike.second << '\n';
+                continue;
+            }
+            out << s;
+            for (uint64_t count : results[s].counts) out << ' ' << count;
+            out << '\n';
+        }
+        std::fprintf(stderr, "%zu samples in %.3f s\n", results.size(), elapsed);
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "snnblaze_run: %s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
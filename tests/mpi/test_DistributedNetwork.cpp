@@ -0,0 +1,93 @@
+// Run with mpiexec -n <ranks> - results must match the single-process engine for any number of ranks
+#include "DistributedNetwork.h"
+#include "LIFNeuron.h"
+#include "ExpCurrentLIFNeuron.h"
+#include "CounterRNG.h"
+#include <gtest/gtest.h>
+#include <mpi.h>
+#include <memory>
+
+// Same construction calls for both engines
+template <typename Network>
+static void build(Network& net) {
+    net.add_neuron_population(40, std::make_shared<LIFNeuron>(0.02, 1.0, 0.0, 0.0, 1.0, 0.002));
+    net.add_neuron_population(30, std::make_shared<ExpCurrentLIFNeuron>(0.02, 0.005, 1.0, 0.0, 0.0, 1.0, 0.002));
+    net.add_neuron_population(3, std::make_shared<LIFNeuron>(0.01, 1.0, 0.0, 0.0, 0.5, 0.001));
+
+    CounterRNG rng(7);
+    for (size_t i = 0; i < 73; ++i)
+        for (size_t j = 0; j < 73; ++j) {
+            uint64_t c = 3 * j;
+            if (i == j || rng.uniform(i, c) >= 0.15) continue;
+            double weight = 0.3 + 0.5 * rng.uniform(i, c + 1);
+            double delay = 0.001 + 0.002 * rng.uniform(i, c + 2);
+            net.add_synapse(Synapse(i, j, weight, delay));
+        }
+    for (size_t k = 0; k < 400; ++k)
+        net.schedule_spike_event(0.2 * rng.uniform(1000, k), k % 73, 0.6 + 0.4 * rng.uniform(2000, k));
+}
+
+class DistributedNetworkTest : public ::testing::Test {
+protected:
+    int rank = 0;
+    void SetUp() override { MPI_Comm_rank(MPI_COMM_WORLD, &rank); }
+};
+
+TEST_F(DistributedNetworkTest, Partitioning) {
+    DistributedNetwork net;
+    build(net);
+    EXPECT_EQ(net.size(), 73);
+
+    // Every neuron has exactly one owner and round-trips through its local index
+    size_t owned = 0;
+    for (size_t i = 0; i < net.size(); ++i) {
+        EXPECT_LT(net.owner(i), net.num_ranks());
+        if (!net.is_local(i)) continue;
+        EXPECT_EQ(net.to_global(net.to_local(i)), i);
+        ++owned;
+    }
+    EXPECT_EQ(owned, net.local().size());
+    size_t total = 0;
+    MPI_Allreduce(&owned, &total, 1, MPI_UNSIGNED_LONG, MPI_SUM, MPI_COMM_WORLD);
+    EXPECT_EQ(total, 73);
+}
+
+TEST_F(DistributedNetworkTest, MatchesSingleProcess) {
+    NeuralNetwork reference;
+    build(reference);
+    auto monitor = std::make_shared<SpikeMonitor>();
+    reference.set_spike_monitor(monitor);
+    reference.run(0.1);
+    reference.run(0.15);
+    auto expected = monitor->spike_list;
+    std::sort(expected.begin(), expected.end());
+
+    DistributedNetwork net;
+    build(net);
+    net.run(0.1);
+    net.run(0.15);
+    auto spikes = net.gather_spikes();
+    auto v = net.gather_population_state(1, 0);
+    auto current = net.gather_population_state(1, 1);
+
+    if (rank != 0) return;
+    ASSERT_GT(expected.size(), 100);
+    EXPECT_EQ(spikes, expected);
+    EXPECT_EQ(v, reference.get_population_state(1, 0));
+    EXPECT_EQ(current, reference.get_population_state(1, 1));
+}
+
+int main(int argc, char** argv) {
+    MPI_Init(&argc, &argv);
+    ::testing::InitGoogleTest(&argc, argv);
+    int rank = 0;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    // Only rank 0 reports
+    if (rank != 0) delete ::testing::UnitTest::GetInstance()->listeners().Release(
+        ::testing::UnitTest::GetInstance()->listeners().default_result_printer());
+    int result = RUN_ALL_TESTS();
+    int failed = result != 0, any_failed = 0;
+    MPI_Allreduce(&failed, &any_failed, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+    MPI_Finalize();
+    return any_failed;
+}
@@ -0,0 +1,81 @@
+#include "NeuralNetwork.h"
+#include "LIFNeuron.h"
+#include "ExpCurrentLIFNeuron.h"
+#include "ProceduralProjection.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <new>
+
+// Test hook: counts heap allocations while enabled
+static std::atomic<bool> counting{false};
+static std::atomic<size_t> allocations{0};
+
+void* operator new(std::size_t size) {
+    if (counting.load(std::memory_order_relaxed)) allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+// The replacement pair is malloc/free based - GCC cannot see that through the inlined operators
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+static size_t count_allocations(NeuralNetwork& net, double T) {
+    allocations = 0;
+    counting = true;
+    net.run(T);
+    counting = false;
+    return allocations;
+}
+
+// Once warm, run() must not touch the heap - every buffer is reserved and reused across runs
+TEST(AllocationTest, SteadyStateRunDoesNotAllocate) {
+    NeuralNetwork net;
+    auto generator = std::make_shared<SpikeGenerator>(50, SpikeGenerator::Mode::Regular, 1);
+    generator->set_rates(std::vector<double>(50, 40.0));
+    net.add_input_population(generator);
+    net.add_neuron_population(200, std::make_shared<LIFNeuron>());
+    net.add_neuron_population(100, std::make_shared<ExpCurrentLIFNeuron>());
+    net.connect_random(0, 1, 0.2, Distribution::uniform(0.0, 0.4), Distribution::uniform(0.001, 0.003), 1);
+    net.connect_random(1, 1, 0.05, Distribution::uniform(0.0, 0.2), Distribution(0.002), 2, false);
+    net.add_stdp_rule(std::make_shared<STDPRule>(50, 200, 50, 200));
+    net.add_projection(std::make_shared<ProceduralProjection>(50, 200, 250, 100,
+        ProceduralProjection::Connectivity::FixedOutDegree, 10, 0.5, 1.0, 0.001, 0.002, 3));
+
+    auto spikes = std::make_shared<SpikeMonitor>();
+    auto states = std::make_shared<StateMonitor>(0.001);
+    net.set_spike_monitor(spikes);
+    net.set_state_monitor(states);
+    net.set_spike_count_monitor(std::make_shared<SpikeCountMonitor>(0.05));
+    net.set_feature_monitor(std::make_shared<FeatureMonitor>(50, 300, 0.01, 100, 0.02));
+    spikes->reserve(1 << 16);
+    net.reserve_events(1 << 16);
+
+    // Warm-up sample
+    net.run(0.2);
+    ASSERT_GT(spikes->spike_list.size(), 50);
+
+    for (int sample = 0; sample < 3; ++sample) {
+        net.reset_monitors();
+        EXPECT_EQ(count_allocations(net, 0.2), 0) << "sample " << sample;
+        EXPECT_GT(spikes->spike_list.size(), 0);
+        EXPECT_GE(states->state_vector_list.size(), 200);
+    }
+}
+
+TEST(AllocationTest, StateMonitorRecyclesVectors) {
+    StateMonitor monitor(1.0);
+    std::vector<double> state(100, 1.0);
+    monitor.reserve(10, state.size());
+    allocations = 0;
+    counting = true;
+    for (int i = 0; i < 10; ++i) monitor.on_read(i, state);
+    monitor.reset_recording();
+    for (int i = 0; i < 10; ++i) monitor.on_read(i, state);
+    counting = false;
+    EXPECT_EQ(allocations, 0);
+    EXPECT_EQ(monitor.state_vector_list.back().second, state);
+}
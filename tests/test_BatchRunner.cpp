@@ -0,0 +1,110 @@
+#include "gtest/gtest.h"
+#include "BatchRunner.h"
+#include "SpikeCountMonitor.h"
+#include <memory>
+#include <sstream>
+#include <vector>
+
+static const char* NETWORK = R"(
+# 20 inputs driving a recurrent LIF reservoir of 50
+population 20 input
+population 50 lif 10.0 1.0 0.0 0.0 1.0 2.0
+connect_fixed_outdegree 0 1 5 uniform:0.5:1.2 1.0 7
+connect_random 1 1 0.1 normal:0.3:0.05 uniform:0.5:2.0 3 0
+synapse 0 20 1.5 0.25   # direct drive
+)";
+
+static const char* INPUTS = R"(
+0 0.0 0
+0 1.5 3 2.0
+2 0.5 19
+0 2.0 0
+1 0.25 7
+)";
+
+TEST(BatchRunnerTest, ParseNetworkSpec) {
+    std::istringstream in(NETWORK);
+    NetworkSpec spec = parse_network_spec(in);
+    ASSERT_EQ(spec.populations.size(), 2);
+    EXPECT_EQ(spec.populations[1].size, 50);
+    EXPECT_EQ(spec.populations[1].model, "lif");
+    EXPECT_EQ(spec.populations[1].args.size(), 6);
+    ASSERT_EQ(spec.connections.size(), 2);
+    EXPECT_EQ(spec.connections[0].p_or_k, 5.0);
+    EXPECT_EQ(spec.connections[0].weight.kind, Distribution::Kind::Uniform);
+    EXPECT_EQ(spec.connections[1].delay.b, 2.0);
+    EXPECT_FALSE(spec.connections[1].allow_autapses);
+    ASSERT_EQ(spec.synapses.size(), 1);
+    EXPECT_EQ(spec.synapses[0].dst_id, 20);
+}
+
+TEST(BatchRunnerTest, ParseInputSamples) {
+    std::istringstream in(INPUTS);
+    auto samples = parse_input_samples(in);
+    ASSERT_EQ(samples.size(), 3);
+    EXPECT_EQ(samples[0].times, (std::vector<double>{0.0, 1.5, 2.0}));
+    EXPECT_EQ(samples[0].neurons, (std::vector<size_t>{0, 3, 0}));
+    EXPECT_EQ(samples[0].weights, (std::vector<double>{1.0, 2.0, 1.0}));
+    EXPECT_EQ(samples[1].neurons, (std::vector<size_t>{7}));
+}
+
+TEST(BatchRunnerTest, ParseErrors) {
+    auto parse = [](const char* text) {
+        std::istringstream in(text);
+        return parse_network_spec(in);
+    };
+    EXPECT_THROW(parse("population 10 hodgkin_huxley"), std::invalid_argument);
+    EXPECT_THROW(parse("population 10 lif 1 2 3 4 5 6 7 8"), std::invalid_argument);
+    EXPECT_THROW(parse("population 10 lif\nsynapse 0 10 1.0 1.0"), std::invalid_argument);
+    EXPECT_THROW(parse("population 10 lif\nconnect_random 0 1 0.1 1.0 1.0"), std::invalid_argument);
+    EXPECT_THROW(parse("population 10 lif\nconnect_random 0 0 0.1 gamma:1:2 1.0"), std::invalid_argument);
+    EXPECT_THROW(parse("population -3 lif"), std::invalid_argument);
+    try {
+        parse("population 10 lif\n\npopulation x lif");
+        FAIL();
+    } catch (const std::invalid_argument& e) {
+        EXPECT_EQ(std::string(e.what()).rfind("line 3:", 0), 0);
+    }
+    std::istringstream inputs("0 0.5");
+    EXPECT_THROW(parse_input_samples(inputs), std::invalid_argument);
+}
+
+// Every sample matches a network built and run on its own, regardless of the thread count
+TEST(BatchRunnerTest, MatchesSequentialRuns) {
+    std::istringstream network(NETWORK), inputs(INPUTS);
+    NetworkSpec spec = parse_network_spec(network);
+    auto samples = parse_input_samples(inputs);
+
+    BatchRunner runner(spec, 20.0);
+    runner.set_readout(20, 50);
+    runner.set_record_spikes(true);
+    auto results = runner.run(samples, 1);
+    ASSERT_EQ(results.size(), 3);
+
+    uint64_t total = 0;
+    for (size_t s = 0; s < samples.size(); ++s) {
+        NeuralNetwork net;
+        build_network(spec, net);
+        auto counts = std::make_shared<SpikeCountMonitor>();
+        net.set_spike_count_monitor(counts);
+        net.schedule_spike_events(samples[s].times, samples[s].neurons, samples[s].weights);
+        net.run(20.0);
+
+        ASSERT_EQ(results[s].counts.size(), 50);
+        EXPECT_EQ(results[s].counts, std::vector<uint64_t>(counts->counts.begin() + 20, counts->counts.end()));
+        for (const auto& spike : results[s].spikes) EXPECT_GE(spike.second, 20);
+        for (uint64_t c : results[s].counts) total += c;
+    }
+    EXPECT_GT(total, 0);
+
+    auto parallel = runner.run(samples, 4);
+    for (size_t s = 0; s < samples.size(); ++s) {
+        EXPECT_EQ(parallel[s].counts, results[s].counts);
+        EXPECT_EQ(parallel[s].spikes, results[s].spikes);
+    }
+
+    EXPECT_THROW(runner.set_readout(60, 20), std::out_of_range);
+    // Errors inside the parallel loop reach the caller
+    samples[1].neurons[0] = 1000;
+    EXPECT_THROW(runner.run(samples, 2), std::out_of_range);
+}
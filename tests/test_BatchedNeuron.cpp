@@ -0,0 +1,164 @@
+#include "BatchedNeuron.h"
+#include "NeuralNetwork.h"
+#include "InputNeuron.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <memory>
+
+// Perfect integrator with threshold 1 and reset to 0
+class Integrator : public Neuron {
+public:
+    void decay(double t, double* state, double* last_spike, double* last_update, size_t n) override {
+        for (size_t i = 0; i < n; ++i) last_update[i] = t;
+    }
+    bool receive(double t, double charge, double* state, double* last_spike, double* last_update) override {
+        *state += charge;
+        if (*state < 1.0) return false;
+        *state = 0.0;
+        *last_spike = t;
+        return true;
+    }
+    double get_init_value() override { return 0.0; }
+};
+
+class BatchedIntegrator : public BatchedNeuron {
+public:
+    using BatchedNeuron::BatchedNeuron;
+
+    void process_batch(size_t n, const size_t* targets, const double* times, const double* charges,
+                       double* state, double* last_spike, double* last_update, size_t n_neurons,
+                       uint8_t* fired) override {
+        ++calls;
+        max_batch = std::max(max_batch, n);
+        for (size_t i = 0; i < n; ++i) {
+            size_t j = targets[i];
+            ASSERT_LT(j, n_neurons);
+            last_update[j] = times[i];
+            state[j] += charges[i];
+            if (state[j] < 1.0) continue;
+            state[j] = 0.0;
+            last_spike[j] = times[i];
+            fired[i] = 1;
+        }
+    }
+    void decay(double t, double* state, double* last_spike, double* last_update, size_t n) override {
+        for (size_t i = 0; i < n; ++i) last_update[i] = t;
+    }
+    double get_init_value() override { return 0.0; }
+
+    size_t calls = 0;
+    size_t max_batch = 0;
+};
+
+// Input layer -> 10 model neurons -> 10 model neurons
+static std::vector<std::pair<double, size_t>> simulate(std::shared_ptr<Neuron> a, std::shared_ptr<Neuron> b, bool with_updates) {
+    NeuralNetwork net;
+    net.add_neuron_population(20, std::make_shared<InputNeuron>());
+    net.add_neuron_population(10, a);
+    net.add_neuron_population(10, b);
+    for (size_t i = 0; i < 20; ++i)
+        for (size_t j = 0; j < 10; ++j) net.add_synapse(Synapse(i, 20 + j, 0.15 + 0.01 * j, 0.002 + 0.0001 * i));
+    for (size_t i = 0; i < 10; ++i)
+        for (size_t j = 0; j < 10; ++j) net.add_synapse(Synapse(20 + i, 30 + j, 0.3, 0.005));
+    for (size_t k = 0; k < 50; ++k) net.schedule_spike_event(0.001 * k, k % 20, 1.0);
+
+    auto monitor = std::make_shared<SpikeMonitor>();
+    net.set_spike_monitor(monitor);
+    if (with_updates) net.set_state_monitor(std::make_shared<StateMonitor>(0.0037));
+    net.run(0.05);
+    net.run(0.05);
+    auto spikes = monitor->spike_list;
+    std::sort(spikes.begin(), spikes.end());
+    return spikes;
+}
+
+TEST(BatchedNeuronTest, MatchesPerEventDelivery) {
+    auto reference = simulate(std::make_shared<Integrator>(), std::make_shared<Integrator>(), false);
+    ASSERT_GT(reference.size(), 60);
+
+    for (bool with_updates : {false, true}) {
+        auto a = std::make_shared<BatchedIntegrator>();
+        auto b = std::make_shared<BatchedIntegrator>(0.001);
+        EXPECT_EQ(simulate(a, b, with_updates), reference);
+        // Fewer model calls than input events
+        EXPECT_GT(a->max_batch, 1);
+        EXPECT_GT(b->max_batch, 1);
+    }
+}
+
+// Without outgoing synapses the default window never ends - the batch is flushed with the run
+TEST(BatchedNeuronTest, SinkPopulation) {
+    NeuralNetwork net;
+    net.add_neuron_population(2, std::make_shared<InputNeuron>());
+    auto sink = std::make_shared<BatchedIntegrator>();
+    net.add_neuron_population(3, sink);
+    net.add_synapse(Synapse(0, 2, 0.6, 0.001));
+    net.add_synapse(Synapse(1, 3, 1.0, 0.001));
+    net.add_synapse(Synapse(1, 4, 0.3, 0.002));
+    for (double t : {0.0, 0.002, 0.004}) {
+        net.schedule_spike_event(t, 0, 1.0);
+        net.schedule_spike_event(t, 1, 1.0);
+    }
+    auto monitor = std::make_shared<SpikeMonitor>();
+    net.set_spike_monitor(monitor);
+    net.run(0.01);
+
+    EXPECT_EQ(sink->calls, 1);
+    EXPECT_EQ(sink->max_batch, 9);
+    auto spikes = monitor->spike_list;
+    std::sort(spikes.begin(), spikes.end());
+    std::vector<std::pair<double, size_t>> expected{{0.0, 0}, {0.0, 1}, {0.001, 3}, {0.002, 0}, {0.002, 1},
+                                                   {0.003, 2}, {0.003, 3}, {0.004, 0}, {0.004, 1}, {0.005, 3}};
+    ASSERT_EQ(spikes.size(), expected.size());
+    for (size_t i = 0; i < spikes.size(); ++i) {
+        EXPECT_NEAR(spikes[i].first, expected[i].first, 1e-12);
+        EXPECT_EQ(spikes[i].second, expected[i].second);
+    }
+
+    // Later runs open a new batch
+    net.schedule_spike_event(0.0, 1, 1.0);
+    net.run(0.01);
+    EXPECT_EQ(sink->calls, 2);
+    // Neuron 4 crosses threshold with its fourth input
+    EXPECT_EQ(monitor->spike_list.size(), expected.size() + 3);
+}
+
+// Spikes of a batched population are emitted late, which plasticity and windowed monitors cannot handle
+TEST(BatchedNeuronTest, RejectsOrderSensitiveObservers) {
+    auto build = [](NeuralNetwork& net) {
+        net.add_neuron_population(2, std::make_shared<InputNeuron>());
+        net.add_neuron_population(3, std::make_shared<BatchedIntegrator>());
+        net.add_synapse(Synapse(0, 2, 0.6, 0.001));
+    };
+    {
+        NeuralNetwork net;
+        build(net);
+        net.add_stdp_rule(std::make_shared<STDPRule>(0, 2, 2, 3));
+        EXPECT_THROW(net.run(0.01), std::logic_error);
+    }
+    {
+        NeuralNetwork net;
+        build(net);
+        net.set_spike_count_monitor(std::make_shared<SpikeCountMonitor>(0.005));
+        EXPECT_THROW(net.run(0.01), std::logic_error);
+        net.set_spike_count_monitor(std::make_shared<SpikeCountMonitor>());
+        EXPECT_NO_THROW(net.run(0.01));
+    }
+    {
+        NeuralNetwork net;
+        build(net);
+        net.set_feature_monitor(std::make_shared<FeatureMonitor>(0, 2, 0.001, 10));
+        EXPECT_NO_THROW(net.run(0.01));
+        net.set_feature_monitor(std::make_shared<FeatureMonitor>(1, 2, 0.001, 10));
+        EXPECT_THROW(net.run(0.01), std::logic_error);
+    }
+}
+
+TEST(BatchedNeuronTest, SingleEventReceive) {
+    BatchedIntegrator neuron;
+    double state = 0.5, last_spike = -1.0, last_update = 0.0;
+    EXPECT_FALSE(neuron.receive(0.1, 0.4, &state, &last_spike, &last_update));
+    EXPECT_TRUE(neuron.receive(0.2, 0.2, &state, &last_spike, &last_update));
+    EXPECT_DOUBLE_EQ(last_spike, 0.2);
+    EXPECT_EQ(neuron.get_num_state_vars(), 1);
+}
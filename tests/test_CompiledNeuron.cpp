@@ -0,0 +1,115 @@
+#include "CompiledNeuron.h"
+#include "NeuralNetwork.h"
+#include "LIFNeuron.h"
+#include "InputNeuron.h"
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <cmath>
+#include <memory>
+
+static std::string cache_dir() {
+    return (std::filesystem::path(::testing::TempDir()) / "snnblaze_model_cache").string();
+}
+
+static ModelDefinition lif_definition() {
+    ModelDefinition def;
+    def.state_vars = {"v"};
+    def.init_values = {0.0};
+    def.params = {{"tau_m", 0.02}, {"C_m", 1.0}, {"v_rest", 0.0}, {"v_reset", 0.0}, {"v_thresh", 1.0}};
+    def.decay = "v = v_rest + (v - v_rest) * exp(-dt / tau_m);";
+    def.input = "v += charge / C_m;";
+    def.threshold = "v >= v_thresh";
+    def.reset = "v = v_reset;";
+    def.refractory = 0.002;
+    return def;
+}
+
+static std::vector<std::pair<double, size_t>> simulate(std::shared_ptr<Neuron> model) {
+    NeuralNetwork net;
+    net.add_neuron_population(5, std::make_shared<InputNeuron>());
+    net.add_neuron_population(20, model);
+    for (size_t i = 0; i < 5; ++i)
+        for (size_t j = 0; j < 20; ++j) net.add_synapse(Synapse(i, 5 + j, 0.2 + 0.02 * j, 0.001));
+    for (size_t k = 0; k < 100; ++k) net.schedule_spike_event(0.0007 * k, k % 5, 1.0);
+    auto monitor = std::make_shared<SpikeMonitor>();
+    net.set_spike_monitor(monitor);
+    net.set_state_monitor(std::make_shared<StateMonitor>(0.005));
+    net.run(0.1);
+    return monitor->spike_list;
+}
+
+// Equation-defined LIF matches the native implementation spike for spike
+TEST(CompiledNeuronTest, MatchesNativeLIF) {
+    auto model = compile_model(lif_definition(), cache_dir());
+    EXPECT_TRUE(std::filesystem::exists(model->library_path_));
+    EXPECT_EQ(model->get_num_state_vars(), 1);
+
+    auto reference = simulate(std::make_shared<LIFNeuron>(0.02, 1.0, 0.0, 0.0, 1.0, 0.002));
+    auto compiled = simulate(model);
+    ASSERT_GT(reference.size(), 20);
+    ASSERT_EQ(compiled.size(), reference.size());
+    for (size_t i = 0; i < reference.size(); ++i) {
+        EXPECT_EQ(compiled[i].second, reference[i].second);
+        EXPECT_NEAR(compiled[i].first, reference[i].first, 1e-12);
+    }
+
+    // Second request hits the cache
+    auto cached = compile_model(lif_definition(), cache_dir());
+    EXPECT_EQ(cached->library_path_, model->library_path_);
+}
+
+// Adaptive threshold: v and theta as two state arrays
+TEST(CompiledNeuronTest, MultiStateModel) {
+    ModelDefinition def;
+    def.state_vars = {"v", "theta"};
+    def.init_values = {0.0, 1.0};
+    def.params = {{"tau_m", 0.02}, {"tau_theta", 0.1}};
+    def.decay = "v *= exp(-dt / tau_m); theta = 1.0 + (theta - 1.0) * exp(-dt / tau_theta);";
+    def.input = "v += charge;";
+    def.threshold = "v >= theta";
+    def.reset = "v = 0.0; theta += 0.5;";
+    auto model = compile_model(def, cache_dir());
+
+    NeuralNetwork net;
+    net.add_neuron_population(1, model);
+    net.schedule_spike_event(0.001, 0, 1.2);   // fires, threshold -> 1.5
+    net.schedule_spike_event(0.002, 0, 1.2);   // below the raised threshold
+    auto monitor = std::make_shared<SpikeMonitor>();
+    net.set_spike_monitor(monitor);
+    net.run(0.01);
+    ASSERT_EQ(monitor->spike_list.size(), 1);
+    // Lazy update - last brought up to date by the second input
+    auto theta = net.get_population_state(0, 1);
+    EXPECT_NEAR(theta[0], 1.0 + 0.5 * std::exp(-0.001 / 0.1), 1e-9);
+}
+
+TEST(CompiledNeuronTest, Errors) {
+    ModelDefinition def = lif_definition();
+    def.state_vars = {"dt"};
+    EXPECT_THROW(generate_model_source(def), std::invalid_argument);
+
+    def = lif_definition();
+    def.decay = "v = undefined_symbol;";
+    try {
+        compile_model(def, cache_dir());
+        FAIL() << "expected a compilation error";
+    } catch (const std::runtime_error& e) {
+        EXPECT_NE(std::string(e.what()).find("undefined_symbol"), std::string::npos);
+    }
+}
+
+// Libraries are only loaded from a private cache
+TEST(CompiledNeuronTest, RefusesSharedCache) {
+    namespace fs = std::filesystem;
+    const fs::path shared = fs::path(::testing::TempDir()) / "snnblaze_shared_cache";
+    fs::create_directories(shared);
+    fs::permissions(shared, fs::perms::all);
+    EXPECT_THROW(compile_model(lif_definition(), shared.string()), std::runtime_error);
+
+    // A planted library is refused as well
+    auto model = compile_model(lif_definition(), cache_dir());
+    fs::permissions(model->library_path_, fs::perms::group_write, fs::perm_options::add);
+    EXPECT_THROW(compile_model(lif_definition(), cache_dir()), std::runtime_error);
+    fs::remove(model->library_path_);
+    fs::remove_all(shared);
+}
@@ -0,0 +1,118 @@
+#include "CompressedProjection.h"
+#include "NeuralNetwork.h"
+#include "LIFNeuron.h"
+#include "Connectivity.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <memory>
+#include <tuple>
+
+using WeightBits = CompressedProjection::WeightBits;
+
+// Decoding returns the staged synapses, sorted by delay then target, with weights within half a quantization step
+TEST(CompressedProjectionTest, RoundTrip) {
+    const size_t n_pre = 50, n_post = 3000;
+    std::vector<std::vector<Synapse>> rows(n_pre + n_post);
+    connect_random(rows, 0, n_pre, n_pre, n_post, 0.1, Distribution::uniform(-0.5, 1.0), Distribution::uniform(0.0, 1.0), 3, true);
+    // Few distinct delays, as required by the delay table
+    for (auto& row : rows)
+        for (auto& syn : row) syn.delay = 0.001 * (1 + static_cast<int>(syn.delay * 8));
+    auto expected = rows;
+
+    for (WeightBits bits : {WeightBits::Int8, WeightBits::Int16}) {
+        auto staged = expected;
+        CompressedProjection proj(0, n_pre, n_pre, n_post, bits);
+        proj.compress(staged);
+        EXPECT_TRUE(std::all_of(staged.begin(), staged.end(), [](const auto& row) { return row.empty(); }));
+
+        size_t total = 0;
+        for (size_t i = 0; i < n_pre; ++i) {
+            auto row = expected[i];
+            std::stable_sort(row.begin(), row.end(), [](const Synapse& a, const Synapse& b) {
+                return std::make_tuple(a.delay, a.dst_id) < std::make_tuple(b.delay, b.dst_id);
+            });
+            std::vector<Synapse> out;
+            proj.generate(i, out);
+            ASSERT_EQ(out.size(), row.size());
+
+            double w_max = 0.0;
+            for (const auto& syn : row) w_max = std::max(w_max, std::abs(syn.weight));
+            double step = w_max / (bits == WeightBits::Int8 ? 127 : 32767);
+            for (size_t k = 0; k < row.size(); ++k) {
+                EXPECT_EQ(out[k].src_id, i);
+                EXPECT_EQ(out[k].dst_id, row[k].dst_id);
+                EXPECT_NEAR(out[k].weight, row[k].weight, 0.51 * step);
+                EXPECT_EQ(out[k].delay, row[k].delay);
+            }
+            total += row.size();
+        }
+        EXPECT_EQ(proj.num_synapses(), total);
+        EXPECT_DOUBLE_EQ(proj.min_delay(), 0.001);
+
+        // Against 24 bytes per synapse in the CSR storage
+        double bytes_per_synapse = static_cast<double>(proj.memory_bytes()) / total;
+        EXPECT_LT(bytes_per_synapse, bits == WeightBits::Int8 ? 3.0 : 4.0);
+    }
+}
+
+// A fixed scale is shared by all rows - weights past the int8 range saturate
+TEST(CompressedProjectionTest, ProjectionScaleAndErrors) {
+    std::vector<std::vector<Synapse>> rows(4);
+    rows[0] = {Synapse(0, 2, 0.25, 0.001), Synapse(0, 3, 100.0, 0.001)};
+    rows[1] = {Synapse(1, 3, -0.5, 0.002)};
+    CompressedProjection proj(0, 2, 2, 2, WeightBits::Int8, 0.25);
+    proj.compress(rows);
+
+    std::vector<Synapse> out;
+    proj.generate(0, out);
+    proj.generate(1, out);
+    ASSERT_EQ(out.size(), 3);
+    EXPECT_DOUBLE_EQ(out[0].weight, 0.25);
+    EXPECT_DOUBLE_EQ(out[1].weight, 127 * 0.25);
+    EXPECT_DOUBLE_EQ(out[2].weight, -0.5);
+
+    proj.scale_weights(2.0);
+    out.clear();
+    proj.generate(1, out);
+    EXPECT_DOUBLE_EQ(out[0].weight, -1.0);
+    EXPECT_THROW(proj.compress(rows), std::invalid_argument);
+
+    std::vector<std::vector<Synapse>> bad(2);
+    bad[0] = {Synapse(0, 0, 1.0, 0.0)};
+    CompressedProjection outside(0, 1, 1, 1);
+    EXPECT_THROW(outside.compress(bad), std::out_of_range);
+
+    bad[0].clear();
+    for (int k = 0; k < 257; ++k) bad[0].emplace_back(0, 1, 1.0, 0.001 * k);
+    CompressedProjection many_delays(0, 1, 1, 1);
+    EXPECT_THROW(many_delays.compress(bad), std::invalid_argument);
+}
+
+// Compressed fan-out gives the same spikes as the CSR storage when the weights are exactly representable
+TEST(CompressedProjectionTest, MatchesStoredSynapses) {
+    auto simulate = [](bool compress) {
+        NeuralNetwork net;
+        net.add_neuron_population(100, std::make_shared<LIFNeuron>(0.02, 1.0, 0.0, 0.0, 1.0, 0.002));
+        net.add_neuron_population(100, std::make_shared<LIFNeuron>(0.02, 1.0, 0.0, 0.0, 1.0, 0.002));
+        size_t n_01 = net.connect_random(0, 1, 0.1, Distribution(0.5), Distribution(0.001), 1);
+        size_t n_10 = net.connect_random(1, 0, 0.05, Distribution(0.25), Distribution(0.002), 2);
+        size_t n_00 = net.connect_random(0, 0, 0.05, Distribution(0.25), Distribution(0.0015), 3, false);
+        if (compress) {
+            auto proj = net.compress_synapses(0, 1);
+            EXPECT_EQ(proj->num_synapses(), n_01);
+            // Other population pairs stay in the CSR storage
+            EXPECT_EQ(net.num_synapses(), n_10 + n_00);
+        }
+        for (size_t i = 0; i < 100; ++i) net.schedule_spike_event(0.001 * i, i, 1.5);
+        auto monitor = std::make_shared<SpikeMonitor>();
+        net.set_spike_monitor(monitor);
+        net.run(0.5);
+        auto spikes = monitor->spike_list;
+        std::sort(spikes.begin(), spikes.end());
+        return spikes;
+    };
+
+    auto stored = simulate(false);
+    EXPECT_GT(stored.size(), 200);
+    EXPECT_EQ(stored, simulate(true));
+}
@@ -0,0 +1,143 @@
+#include "Connectivity.h"
+#include "NeuralNetwork.h"
+#include "LIFNeuron.h"
+#include <gtest/gtest.h>
+#include <omp.h>
+#include <cmath>
+#include <memory>
+#include <set>
+
+using Rows = std::vector<std::vector<Synapse>>;
+
+static bool same_rows(const Rows& a, const Rows& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].size() != b[i].size()) return false;
+        for (size_t s = 0; s < a[i].size(); ++s)
+            if (a[i][s].dst_id != b[i][s].dst_id || a[i][s].weight != b[i][s].weight || a[i][s].delay != b[i][s].delay)
+                return false;
+    }
+    return true;
+}
+
+TEST(ConnectivityTest, RandomIsThreadIndependent) {
+    Rows one(2000), many(2000);
+    int threads = omp_get_max_threads();
+    omp_set_num_threads(1);
+    size_t n = connect_random(one, 0, 2000, 0, 2000, 0.02, Distribution::uniform(0.1, 0.2), Distribution(0.001), 5, false);
+    omp_set_num_threads(4);
+    connect_random(many, 0, 2000, 0, 2000, 0.02, Distribution::uniform(0.1, 0.2), Distribution(0.001), 5, false);
+    omp_set_num_threads(threads);
+
+    EXPECT_TRUE(same_rows(one, many));
+    EXPECT_NEAR(n / (2000.0 * 2000.0), 0.02, 0.001);
+    for (size_t i = 0; i < one.size(); ++i)
+        for (const auto& syn : one[i]) {
+            EXPECT_NE(syn.dst_id, i);
+            EXPECT_GE(syn.weight, 0.1);
+            EXPECT_LT(syn.weight, 0.2);
+        }
+}
+
+TEST(ConnectivityTest, FixedDegrees) {
+    Rows rows(150);
+    EXPECT_EQ(connect_fixed_outdegree(rows, 0, 100, 50, 100, 10, Distribution(1.0), Distribution(0.0), 1, false), 1000);
+    for (size_t i = 0; i < 100; ++i) {
+        std::set<size_t> targets;
+        for (const auto& syn : rows[i]) targets.insert(syn.dst_id);
+        EXPECT_EQ(targets.size(), 10);
+        EXPECT_EQ(targets.count(i), 0);
+        EXPECT_GE(*targets.begin(), 50);
+    }
+
+    Rows in_rows(100);
+    EXPECT_EQ(connect_fixed_indegree(in_rows, 0, 100, 0, 100, 99, Distribution(1.0), Distribution(0.0), 1, false), 9900);
+    std::vector<std::set<size_t>> sources(100);
+    for (size_t i = 0; i < 100; ++i)
+        for (const auto& syn : in_rows[i]) sources[syn.dst_id].insert(i);
+    for (size_t j = 0; j < 100; ++j) {
+        EXPECT_EQ(sources[j].size(), 99);
+        EXPECT_EQ(sources[j].count(j), 0);
+    }
+
+    EXPECT_THROW(connect_fixed_indegree(in_rows, 0, 100, 0, 100, 100, Distribution(1.0), Distribution(0.0), 1, false), std::invalid_argument);
+
+    // Empty populations: nothing to connect, and no target or source for k > 0
+    EXPECT_EQ(connect_fixed_outdegree(rows, 0, 10, 10, 0, 0, Distribution(1.0), Distribution(0.0), 1, false), 0);
+    EXPECT_EQ(connect_fixed_indegree(rows, 0, 0, 0, 10, 0, Distribution(1.0), Distribution(0.0), 1, false), 0);
+    EXPECT_THROW(connect_fixed_outdegree(rows, 0, 10, 10, 0, 1, Distribution(1.0), Distribution(0.0), 1, false), std::invalid_argument);
+    EXPECT_THROW(connect_fixed_indegree(rows, 0, 0, 0, 10, 1, Distribution(1.0), Distribution(0.0), 1, false), std::invalid_argument);
+}
+
+TEST(ConnectivityTest, DistanceDependent) {
+    auto pos = grid_positions(10, 10, 10);
+    ASSERT_EQ(pos.size(), 3000);
+    Rows rows(1000);
+    connect_distance(rows, 0, pos, 0, pos, 1.0, 1e-3, Distribution(1.0), Distribution(0.0), 2, false);
+    for (const auto& row : rows) EXPECT_TRUE(row.empty());
+
+    // Only direct neighbours are reachable with a short lambda
+    connect_distance(rows, 0, pos, 0, pos, 1.0, 0.5, Distribution(1.0), Distribution(0.0), 2, false);
+    size_t n = 0;
+    for (size_t i = 0; i < rows.size(); ++i)
+        for (const auto& syn : rows[i]) {
+            double d2 = 0.0;
+            for (int c = 0; c < 3; ++c) d2 += std::pow(pos[3 * i + c] - pos[3 * syn.dst_id + c], 2);
+            EXPECT_LE(d2, 3.0);
+            ++n;
+        }
+    EXPECT_GT(n, 0);
+}
+
+TEST(ConnectivityTest, SmallWorld) {
+    Rows rows(20);
+    connect_small_world(rows, 0, 20, 4, 0.0, Distribution(1.0), Distribution(0.0), 3);
+    std::set<size_t> expected = {18, 19, 1, 2};
+    std::set<size_t> targets;
+    for (const auto& syn : rows[0]) targets.insert(syn.dst_id);
+    EXPECT_EQ(targets, expected);
+
+    // Rewiring never duplicates an edge of the row or creates a self-connection
+    for (double beta : {0.3, 1.0}) {
+        Rows rewired(20);
+        EXPECT_EQ(connect_small_world(rewired, 0, 20, 16, beta, Distribution(1.0), Distribution(0.0), 5), 20 * 16);
+        for (size_t i = 0; i < 20; ++i) {
+            std::set<size_t> row_targets;
+            for (const auto& syn : rewired[i]) row_targets.insert(syn.dst_id);
+            EXPECT_EQ(row_targets.size(), 16);
+            EXPECT_EQ(row_targets.count(i), 0);
+        }
+    }
+
+    EXPECT_THROW(connect_small_world(rows, 0, 20, 3, 0.1, Distribution(1.0), Distribution(0.0), 3), std::invalid_argument);
+}
+
+TEST(ConnectivityTest, NormalDistribution) {
+    CounterRNG rng(9);
+    Distribution d = Distribution::normal(2.0, 0.5);
+    double sum = 0.0, sq = 0.0;
+    const int n = 20000;
+    for (int i = 0; i < n; ++i) {
+        double x = d.sample(rng, 0, i);
+        sum += x;
+        sq += x * x;
+    }
+    EXPECT_NEAR(sum / n, 2.0, 0.02);
+    EXPECT_NEAR(std::sqrt(sq / n - (sum / n) * (sum / n)), 0.5, 0.02);
+}
+
+TEST(ConnectivityTest, NetworkGenerators) {
+    NeuralNetwork net;
+    net.add_neuron_population(100, std::make_shared<LIFNeuron>());
+    net.add_neuron_population(50, std::make_shared<LIFNeuron>());
+    size_t n = net.connect_random(0, 1, 0.1, Distribution(0.5), Distribution::uniform(0.001, 0.002), 4);
+    n += net.connect_fixed_outdegree(1, 0, 3, Distribution(0.5), Distribution(0.001), 4);
+    EXPECT_THROW(net.connect_random(0, 2, 0.1, Distribution(0.5), Distribution(0.0)), std::out_of_range);
+
+    auto synapses = net.get_synapses();
+    ASSERT_EQ(synapses.size(), n);
+    for (const auto& syn : synapses) {
+        if (syn.src_id < 100) EXPECT_GE(syn.dst_id, 100);
+        else EXPECT_LT(syn.dst_id, 100);
+    }
+}
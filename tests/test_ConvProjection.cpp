@@ -0,0 +1,73 @@
+#include "ConvProjection.h"
+#include "NeuralNetwork.h"
+#include "InputNeuron.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <memory>
+
+// Brute-force fan-out of input (c, y, x) computed from the output side
+static std::vector<std::pair<size_t, double>> reference_fanout(const ConvProjection& p, size_t c, size_t y, size_t x) {
+    std::vector<std::pair<size_t, double>> out;
+    for (size_t co = 0; co < p.out_channels_; ++co)
+        for (size_t oy = 0; oy < p.out_height(); ++oy)
+            for (size_t ox = 0; ox < p.out_width(); ++ox)
+                for (size_t ky = 0; ky < p.kernel_h_; ++ky)
+                    for (size_t kx = 0; kx < p.kernel_w_; ++kx) {
+                        long iy = long(oy * p.stride_ + ky) - long(p.padding_);
+                        long ix = long(ox * p.stride_ + kx) - long(p.padding_);
+                        if (iy != long(y) || ix != long(x)) continue;
+                        size_t k = ky * p.kernel_w_ + kx;
+                        double w = p.weights_[(co * p.in_channels_ + c) * p.kernel_h_ * p.kernel_w_ + k];
+                        out.emplace_back(p.post_begin_ + (co * p.out_height() + oy) * p.out_width() + ox, w);
+                    }
+    std::sort(out.begin(), out.end());
+    return out;
+}
+
+TEST(ConvProjectionTest, MatchesDenseConvolution) {
+    std::vector<double> weights(3 * 2 * 3 * 3);
+    for (size_t i = 0; i < weights.size(); ++i) weights[i] = 0.1 * (i + 1);
+    ConvProjection conv(0, 2, 7, 6, 84, 3, 3, 3, weights, 0.001, 2, 1);
+    EXPECT_EQ(conv.out_height(), 4);
+    EXPECT_EQ(conv.out_width(), 3);
+    EXPECT_EQ(conv.n_pre_, 84);
+    EXPECT_EQ(conv.n_post_, 36);
+
+    for (size_t c = 0; c < 2; ++c)
+        for (size_t y = 0; y < 7; ++y)
+            for (size_t x = 0; x < 6; ++x) {
+                std::vector<Synapse> syn;
+                conv.generate((c * 7 + y) * 6 + x, syn);
+                std::vector<std::pair<size_t, double>> got;
+                for (const auto& s : syn) got.emplace_back(s.dst_id, s.weight);
+                std::sort(got.begin(), got.end());
+                EXPECT_EQ(got, reference_fanout(conv, c, y, x));
+            }
+}
+
+TEST(ConvProjectionTest, DepthwiseNeighborhood) {
+    // 3x3 neighbourhood of ones per channel, same-size output
+    ConvProjection conv(0, 2, 4, 4, 32, 2, 3, 3, std::vector<double>(2 * 9, 1.0), 0.0, 1, 1, true);
+    EXPECT_EQ(conv.n_post_, 32);
+    std::vector<Synapse> syn;
+    conv.generate(16 + 5, syn);     // channel 1, (1, 1) - interior
+    EXPECT_EQ(syn.size(), 9);
+    for (const auto& s : syn) EXPECT_GE(s.dst_id, 32 + 16);
+    syn.clear();
+    conv.generate(0, syn);          // corner
+    EXPECT_EQ(syn.size(), 4);
+
+    EXPECT_THROW(ConvProjection(0, 1, 4, 4, 16, 1, 3, 3, std::vector<double>(8, 1.0)), std::invalid_argument);
+    EXPECT_THROW(ConvProjection(0, 1, 2, 2, 4, 1, 3, 3, std::vector<double>(9, 1.0)), std::invalid_argument);
+}
+
+TEST(ConvProjectionTest, NetworkFanOut) {
+    NeuralNetwork net;
+    net.add_neuron_population(25 + 9, std::make_shared<InputNeuron>());
+    net.add_projection(std::make_shared<ConvProjection>(0, 1, 5, 5, 25, 1, 3, 3, std::vector<double>(9, 1.0), 0.001));
+    auto monitor = std::make_shared<SpikeMonitor>();
+    net.set_spike_monitor(monitor);
+    net.schedule_spike_event(0.0, 12, 1.0);     // centre pixel reaches every output
+    net.run(0.01);
+    EXPECT_EQ(monitor->spike_list.size(), 1 + 9);
+}
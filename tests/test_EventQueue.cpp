@@ -0,0 +1,70 @@
+#include "gtest/gtest.h"
+#include "Event.h"
+#include <vector>
+
+static double time_of(const Event& ev) {
+    return std::visit([](const auto& e) { return e.time; }, ev);
+}
+
+// Heap events and lane packets come out merged in time order
+TEST(EventQueueTest, MergesLanesAndHeap) {
+    EventQueue q;
+    q.set_num_lanes(2);
+    q.push(PacketEvent{1.0, 0}, 0);
+    q.push(PacketEvent{3.0, 1}, 0);
+    q.push(PacketEvent{2.0, 2}, 1);
+    q.push(PacketEvent{4.0, 3}, 1);
+    q.push(SpikeEvent{2.5, 0, 1.0});
+    q.push(UpdateEvent{0.5});
+    EXPECT_EQ(q.size(), 6);
+
+    std::vector<double> times;
+    while (!q.empty()) {
+        double t = q.next_time();
+        Event ev = q.pop();
+        EXPECT_EQ(time_of(ev), t);
+        times.push_back(t);
+    }
+    EXPECT_EQ(times, (std::vector<double>{0.5, 1.0, 2.0, 2.5, 3.0, 4.0}));
+}
+
+// Packets out of order for their lane, or without a lane, fall back to the heap
+TEST(EventQueueTest, OutOfOrderFallsBackToHeap) {
+    EventQueue q;
+    q.set_num_lanes(1);
+    q.push(PacketEvent{5.0, 0}, 0);
+    q.push(PacketEvent{2.0, 1}, 0);
+    q.push(PacketEvent{1.0, 2}, EventQueue::NO_LANE);
+    q.push(PacketEvent{3.0, 3}, 7);
+
+    std::vector<size_t> groups;
+    while (!q.empty()) groups.push_back(std::get<PacketEvent>(q.pop()).group);
+    EXPECT_EQ(groups, (std::vector<size_t>{2, 1, 3, 0}));
+}
+
+// Lanes grow past their initial capacity and keep FIFO order across wrap-around
+TEST(EventQueueTest, LaneGrowth) {
+    EventQueue q;
+    q.set_num_lanes(1);
+    size_t next = 0;
+    for (size_t i = 0; i < 50; ++i) q.push(PacketEvent{double(i), i}, 0);
+    for (; next < 40; ++next) EXPECT_EQ(std::get<PacketEvent>(q.pop()).group, next);
+    for (size_t i = 50; i < 300; ++i) q.push(PacketEvent{double(i), i}, 0);
+    for (; next < 300; ++next) EXPECT_EQ(std::get<PacketEvent>(q.pop()).group, next);
+    EXPECT_TRUE(q.empty());
+}
+
+TEST(EventQueueTest, TakePackets) {
+    EventQueue q;
+    q.set_num_lanes(1);
+    q.push(PacketEvent{1.0, 0}, 0);
+    q.push(PacketEvent{2.0, 1}, EventQueue::NO_LANE);
+    q.push(SpikeEvent{1.5, 0, 1.0});
+    q.push(UpdateEvent{3.0});
+
+    auto packets = q.take_packets();
+    EXPECT_EQ(packets.size(), 2);
+    ASSERT_EQ(q.size(), 2);
+    EXPECT_TRUE(std::holds_alternative<SpikeEvent>(q.pop()));
+    EXPECT_TRUE(std::holds_alternative<UpdateEvent>(q.pop()));
+}
@@ -0,0 +1,76 @@
+#include "FeatureMonitor.h"
+#include "NeuralNetwork.h"
+#include "InputNeuron.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <memory>
+
+TEST(FeatureMonitorTest, BinnedCounts) {
+    FeatureMonitor monitor(2, 3, 0.5, 4);
+    monitor.on_run_start(1.0);
+    monitor.on_spike(1.1, 2);
+    monitor.on_spike(1.2, 2);
+    monitor.on_spike(1.6, 4);
+    monitor.on_spike(1.7, 1);   // outside neuron range
+    monitor.on_spike(5.0, 3);   // past the last bin
+    monitor.on_run_end(3.0);
+
+    EXPECT_DOUBLE_EQ(monitor.counts[0 * 3 + 0], 2.0);
+    EXPECT_DOUBLE_EQ(monitor.counts[1 * 3 + 2], 1.0);
+    double total = 0.0;
+    for (double c : monitor.counts) total += c;
+    EXPECT_DOUBLE_EQ(total, 3.0);
+    EXPECT_TRUE(monitor.traces.empty());
+}
+
+// Traces match an exponential kernel convolved with the binned impulses
+TEST(FeatureMonitorTest, ExponentialTraces) {
+    double dt = 0.01, tau = 0.05;
+    FeatureMonitor monitor(0, 1, dt, 10, tau);
+    monitor.on_run_start(0.0);
+    monitor.on_spike(0.005, 0);
+    monitor.on_run_end(0.03);
+    monitor.on_run_start(0.03);
+    monitor.on_spike(0.035, 0);
+    monitor.on_run_end(0.1);
+
+    for (size_t b = 0; b < 10; ++b) {
+        double expected = std::exp(-(b * dt) / tau) / dt;
+        if (b >= 3) expected += std::exp(-((b - 3) * dt) / tau) / dt;
+        EXPECT_NEAR(monitor.traces[b], expected, 1e-9);
+    }
+}
+
+TEST(FeatureMonitorTest, ResetRecording) {
+    FeatureMonitor monitor(0, 2, 1.0, 2, 1.0);
+    monitor.on_run_start(0.0);
+    monitor.on_spike(0.5, 1);
+    monitor.on_run_end(2.0);
+    monitor.reset_recording();
+
+    for (double c : monitor.counts) EXPECT_EQ(c, 0.0);
+    for (double v : monitor.traces) EXPECT_EQ(v, 0.0);
+
+    // Bins restart at the next run
+    monitor.on_run_start(10.0);
+    monitor.on_spike(10.5, 0);
+    EXPECT_DOUBLE_EQ(monitor.counts[0], 1.0);
+}
+
+// Features are relative to the first run after reset_monitors
+TEST(FeatureMonitorTest, AttachedToNetwork) {
+    NeuralNetwork net;
+    net.add_neuron_population(2, std::make_shared<InputNeuron>());
+    auto monitor = std::make_shared<FeatureMonitor>(0, 2, 0.1, 10, 0.05);
+    net.set_feature_monitor(monitor);
+
+    net.run(1.0);
+    net.reset_monitors();
+    net.schedule_spike_event(0.25, 1, 1.0);
+    net.schedule_spike_event(0.55, 0, 1.0);
+    net.run(1.0);
+
+    EXPECT_DOUBLE_EQ(monitor->counts[2 * 2 + 1], 1.0);
+    EXPECT_DOUBLE_EQ(monitor->counts[5 * 2 + 0], 1.0);
+    EXPECT_NEAR(monitor->traces[3 * 2 + 1], std::exp(-0.1 / 0.05) / 0.1, 1e-9);
+}
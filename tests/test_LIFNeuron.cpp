@@ -64,3 +64,24 @@ TEST_F(LIFNeuronTest, RefractoryTest) {
 TEST_F(LIFNeuronTest, GetInitValueTest) {
     EXPECT_EQ(neuron.get_init_value(), v_reset);
 }
+
+// Bias current moves the resting point and the crossing time is predicted analytically
+TEST_F(LIFNeuronTest, BiasSpikePrediction) {
+    LIFNeuron biased{tau_m, C_m, v_rest, v_reset, v_thresh, refractory, 0.2};  // v_inf = 2.0
+    double* vars[1 + LIFNeuron::NUM_PARAMS] = {&state};
+    state = 0.0;
+
+    EXPECT_TRUE(biased.predicts_spikes(vars, 1));
+    EXPECT_FALSE(neuron.predicts_spikes(vars, 1));
+
+    double t_cross = biased.next_spike_time(vars, &last_spike, &last_update);
+    EXPECT_NEAR(t_cross, tau_m * std::log(2.0), 1e-12);
+
+    biased.decay(t_cross, &state, &last_spike, &last_update, 1);
+    EXPECT_NEAR(state, v_thresh, 1e-12);
+
+    // After firing the next crossing is measured from the spike (refractory period included)
+    biased.fire_vars(t_cross, vars, &last_spike, &last_update);
+    EXPECT_EQ(state, v_reset);
+    EXPECT_NEAR(biased.next_spike_time(vars, &last_spike, &last_update), 2 * t_cross, 1e-12);
+}
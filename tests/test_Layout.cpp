@@ -0,0 +1,108 @@
+#include "gtest/gtest.h"
+#include "Layout.h"
+#include "NeuralNetwork.h"
+#include "LIFNeuron.h"
+#include "ExpCurrentLIFNeuron.h"
+#include "CounterRNG.h"
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <tuple>
+#include <vector>
+
+// A ring whose ids were shuffled is laid out back into a band
+TEST(LayoutTest, ReverseCuthillMcKeeRecoversRing) {
+    const size_t n = 200;
+    std::vector<size_t> shuffled(n);
+    std::iota(shuffled.begin(), shuffled.end(), 0);
+    CounterRNG rng(3);
+    for (size_t i = n - 1; i > 0; --i) std::swap(shuffled[i], shuffled[static_cast<size_t>(rng.uniform(0, i) * (i + 1))]);
+
+    std::vector<std::vector<Synapse>> rows(n);
+    for (size_t i = 0; i < n; ++i)
+        rows[shuffled[i]].emplace_back(shuffled[i], shuffled[(i + 1) % n], 1.0, 1.0);
+    SynapseMatrix m;
+    m.append(rows);
+
+    std::vector<size_t> identity(n);
+    std::iota(identity.begin(), identity.end(), 0);
+    std::vector<size_t> order = reverse_cuthill_mckee(m);
+    ASSERT_EQ(order.size(), n);
+    std::vector<size_t> position(n);
+    for (size_t k = 0; k < n; ++k) position[order[k]] = k;
+
+    EXPECT_GT(layout_bandwidth(m, identity), n / 2);
+    EXPECT_LE(layout_bandwidth(m, position), 2);
+}
+
+// Same construction calls, with or without the layout pass
+static void build(NeuralNetwork& net, bool optimize, std::shared_ptr<SpikeMonitor> spikes, std::shared_ptr<StateMonitor> states) {
+    net.add_neuron_population(80, std::make_shared<LIFNeuron>(0.02, 1.0, 0.0, 0.0, 1.0, 0.002));
+    net.add_neuron_population(40, std::make_shared<ExpCurrentLIFNeuron>(0.02, 0.005, 1.0, 0.0, 0.0, 1.0, 0.002));
+    net.connect_random(0, 0, 0.1, Distribution::uniform(0.1, 0.5), Distribution(0.001), 1, false);
+    net.connect_random(0, 1, 0.1, Distribution::uniform(0.2, 0.6), Distribution(0.002), 2);
+    net.connect_random(1, 0, 0.1, Distribution::uniform(0.2, 0.6), Distribution(0.0015), 3);
+    std::vector<double> thresholds(80);
+    for (size_t i = 0; i < 80; ++i) thresholds[i] = 0.8 + 0.005 * i;
+    net.set_population_param(0, "v_thresh", thresholds);
+    CounterRNG rng(5);
+    for (size_t k = 0; k < 200; ++k)
+        net.schedule_spike_event(0.05 * rng.uniform(1, k), k % 120, 1.2);
+
+    if (optimize) net.optimize_layout();
+    // Added with user ids after the layout pass
+    net.add_synapse(Synapse(3, 100, 0.7, 0.001));
+    net.set_spike_monitor(spikes);
+    net.set_state_monitor(states);
+}
+
+TEST(LayoutTest, OptimizedLayoutMatchesIdOrder) {
+    NeuralNetwork plain, optimized;
+    auto plain_spikes = std::make_shared<SpikeMonitor>(), optimized_spikes = std::make_shared<SpikeMonitor>();
+    auto plain_states = std::make_shared<StateMonitor>(0.01), optimized_states = std::make_shared<StateMonitor>(0.01);
+    build(plain, false, plain_spikes, plain_states);
+    build(optimized, true, optimized_spikes, optimized_states);
+
+    // Every population was renumbered
+    std::vector<size_t> layout = optimized.get_layout();
+    ASSERT_EQ(layout.size(), 120);
+    EXPECT_FALSE(std::is_sorted(layout.begin(), layout.begin() + 80));
+    EXPECT_FALSE(std::is_sorted(layout.begin() + 80, layout.end()));
+    EXPECT_TRUE(std::all_of(layout.begin(), layout.begin() + 80, [](size_t id) { return id < 80; }));
+
+    plain.run(0.1);
+    optimized.run(0.1);
+    optimized.schedule_spike_event(0.01, 7, 1.5);
+    plain.schedule_spike_event(0.01, 7, 1.5);
+    plain.run(0.1);
+    optimized.run(0.1);
+
+    // Events at equal times may be processed in a different order
+    auto plain_list = plain_spikes->spike_list, optimized_list = optimized_spikes->spike_list;
+    std::sort(plain_list.begin(), plain_list.end());
+    std::sort(optimized_list.begin(), optimized_list.end());
+    EXPECT_GT(plain_list.size(), 100);
+    EXPECT_EQ(plain_list, optimized_list);
+
+    ASSERT_EQ(plain_states->state_vector_list.size(), optimized_states->state_vector_list.size());
+    for (size_t r = 0; r < plain_states->state_vector_list.size(); ++r)
+        for (size_t i = 0; i < 120; ++i)
+            EXPECT_NEAR(plain_states->state_vector_list[r].second[i], optimized_states->state_vector_list[r].second[i], 1e-12);
+    for (size_t var = 0; var < 2; ++var) {
+        auto a = plain.get_population_state(1, var), b = optimized.get_population_state(1, var);
+        for (size_t i = 0; i < 40; ++i) EXPECT_NEAR(a[i], b[i], 1e-12);
+    }
+    EXPECT_EQ(plain.get_population_param(0, "v_thresh"), optimized.get_population_param(0, "v_thresh"));
+
+    // Same synapses in user ids, only the storage order differs
+    auto key = [](const Synapse& s) { return std::make_tuple(s.src_id, s.dst_id, s.weight, s.delay); };
+    auto sorted_synapses = [&](NeuralNetwork& net) {
+        std::vector<std::tuple<size_t, size_t, double, double>> keys;
+        for (const auto& s : net.get_synapses()) keys.push_back(key(s));
+        std::sort(keys.begin(), keys.end());
+        return keys;
+    };
+    EXPECT_EQ(sorted_synapses(plain), sorted_synapses(optimized));
+
+    EXPECT_THROW(optimized.optimize_layout(), std::logic_error);
+}
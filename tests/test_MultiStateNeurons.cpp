@@ -0,0 +1,246 @@
+#include "ExpCurrentLIFNeuron.h"
+#include "AdExNeuron.h"
+#include "IzhikevichNeuron.h"
+#include "NeuralNetwork.h"
+#include "LIFNeuron.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
+#include <memory>
+
+class MultiStateNeuronTest : public ::testing::Test {
+protected:
+    double v[2] = {0.0, 0.0};
+    double x[2] = {0.0, 0.0};
+    // Remaining entries (per-neuron parameters) are null for homogeneous populations
+    double* vars[NeuronPopulation::MAX_STATE_VARS + NeuronPopulation::MAX_PARAMS] = {v, x};
+    double last_spike[2] = {-std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity()};
+    double last_update[2] = {0.0, 0.0};
+};
+
+// Injected charge flows in through the current, matching the analytic solution
+TEST_F(MultiStateNeuronTest, ExpCurrentLIFDecay) {
+    double tau_m = 10.0, tau_syn = 2.0, C_m = 1.0;
+    ExpCurrentLIFNeuron neuron(tau_m, tau_syn, C_m, 0.0, 0.0, 1.0, 0.0);
+    EXPECT_EQ(neuron.get_num_state_vars(), 2);
+
+    EXPECT_FALSE(neuron.receive_vars(0.0, 0.5, vars, last_spike, last_update));
+    EXPECT_DOUBLE_EQ(v[0], 0.0);
+    EXPECT_DOUBLE_EQ(x[0], 0.25);
+
+    double t = 3.0;
+    neuron.decay_vars(t, vars, last_spike, last_update, 1);
+    double A = 0.25 * tau_m * tau_syn / (C_m * (tau_syn - tau_m));
+    EXPECT_NEAR(v[0], -A * std::exp(-t / tau_m) + A * std::exp(-t / tau_syn), 1e-12);
+    EXPECT_NEAR(x[0], 0.25 * std::exp(-t / tau_syn), 1e-12);
+    EXPECT_EQ(last_update[0], t);
+}
+
+// Potential is held at reset during the refractory period while the current keeps decaying
+TEST_F(MultiStateNeuronTest, ExpCurrentLIFRefractory) {
+    ExpCurrentLIFNeuron neuron(10.0, 2.0, 1.0, 0.0, 0.0, 1.0, 1.0);
+    v[0] = 2.0;
+    x[0] = 1.0;
+    EXPECT_TRUE(neuron.receive_vars(0.0, 0.0, vars, last_spike, last_update));
+    EXPECT_EQ(v[0], 0.0);
+
+    neuron.decay_vars(0.5, vars, last_spike, last_update, 1);
+    EXPECT_EQ(v[0], 0.0);
+    EXPECT_NEAR(x[0], std::exp(-0.5 / 2.0), 1e-12);
+
+    neuron.decay_vars(2.0, vars, last_spike, last_update, 1);
+    EXPECT_GT(v[0], 0.0);
+}
+
+// Constant depolarization makes AdEx fire and adapt
+TEST_F(MultiStateNeuronTest, AdExSpikeAndAdaptation) {
+    AdExNeuron neuron;
+    v[0] = neuron.get_init_state(0);
+    x[0] = neuron.get_init_state(1);
+
+    // Large input crosses the peak immediately
+    EXPECT_TRUE(neuron.receive_vars(0.0, 1.0, vars, last_spike, last_update));
+    EXPECT_DOUBLE_EQ(v[0], neuron.v_reset_);
+    EXPECT_DOUBLE_EQ(x[0], neuron.b_);
+
+    // Adaptation current decays towards zero at rest
+    neuron.decay_vars(0.5, vars, last_spike, last_update, 1);
+    EXPECT_LT(x[0], neuron.b_);
+    EXPECT_NEAR(v[0], neuron.E_L_, 5e-3);
+
+    // Above the soft threshold the neuron runs away and is held at the peak
+    v[0] = -40e-3;
+    neuron.decay_vars(0.6, vars, last_spike, last_update, 1);
+    EXPECT_DOUBLE_EQ(v[0], neuron.v_peak_);
+    EXPECT_TRUE(neuron.receive_vars(0.6, 0.0, vars, last_spike, last_update));
+}
+
+TEST_F(MultiStateNeuronTest, IzhikevichRestAndSpike) {
+    IzhikevichNeuron neuron;
+    v[0] = neuron.get_init_state(0);
+    x[0] = neuron.get_init_state(1);
+    EXPECT_DOUBLE_EQ(x[0], neuron.b_ * neuron.c_);
+
+    // Relaxes to the resting potential of the regular spiking neuron
+    neuron.decay_vars(1.0, vars, last_spike, last_update, 1);
+    EXPECT_NEAR(v[0], -70.0, 0.5);
+
+    double u = x[0];
+    EXPECT_TRUE(neuron.receive_vars(1.0, 200.0, vars, last_spike, last_update));
+    EXPECT_DOUBLE_EQ(v[0], neuron.c_);
+    EXPECT_DOUBLE_EQ(x[0], u + neuron.d_);
+    EXPECT_EQ(last_spike[0], 1.0);
+}
+
+// Network stores every state variable as its own array and drives the multi-state kernels
+TEST_F(MultiStateNeuronTest, NetworkMultiStatePopulation) {
+    NeuralNetwork net;
+    net.add_neuron_population(1, std::make_shared<LIFNeuron>(10.0, 1.0, 0.0, 0.0, 1.0, 0.0));
+    net.add_neuron_population(3, std::make_shared<ExpCurrentLIFNeuron>(10.0, 1.0, 1.0, 0.0, 0.0, 0.5, 0.0));
+    net.add_neuron_population(2, std::make_shared<IzhikevichNeuron>());
+    EXPECT_EQ(net.size(), 6);
+
+    // Input current into neuron 2 takes it over threshold three times (crossings of ExpCurrentLIFPredictedCrossing)
+    net.schedule_spike_event(0.0, 2, 2.0);
+    net.schedule_spike_event(1.0, 2, 0.0);
+    auto monitor = std::make_shared<SpikeMonitor>();
+    net.set_spike_monitor(monitor);
+    net.run(2.0);
+
+    const double expected[3] = {0.2928413750231185, 0.7123582777578916, 1.4712357718217604};
+    ASSERT_EQ(monitor->spike_list.size(), 3);
+    for (size_t k = 0; k < 3; ++k) {
+        EXPECT_EQ(monitor->spike_list[k].second, 2);
+        EXPECT_NEAR(monitor->spike_list[k].first, expected[k], 1e-9);
+    }
+
+    // The state was last brought up to date by the last spike
+    auto current = net.get_population_state(1, 1);
+    ASSERT_EQ(current.size(), 3);
+    EXPECT_NEAR(current[1], 2.0 * std::exp(-monitor->spike_list[2].first), 1e-12);
+    EXPECT_EQ(current[0], 0.0);
+
+    // Izhikevich neurons relax to rest (u = b v_rest) through their predicted trajectory, without spiking
+    auto recovery = net.get_population_state(2, 1);
+    EXPECT_NEAR(recovery[0], 0.2 * -70.0, 1e-3);
+    EXPECT_THROW(net.get_population_state(0, 1), std::out_of_range);
+}
+
+// Current-driven crossing between inputs is scheduled at the exact time
+TEST_F(MultiStateNeuronTest, ExpCurrentLIFPredictedCrossing) {
+    double tau_m = 10.0, tau_syn = 1.0, C_m = 1.0, v_thresh = 0.5;
+    NeuralNetwork net;
+    net.add_neuron_population(1, std::make_shared<ExpCurrentLIFNeuron>(tau_m, tau_syn, C_m, 0.0, 0.0, v_thresh, 0.0));
+    auto monitor = std::make_shared<SpikeMonitor>();
+    net.set_spike_monitor(monitor);
+    net.schedule_spike_event(0.0, 0, 2.0);
+    net.run(5.0);
+
+    // Reference crossings from an independent bisection of the trajectory, restarted from reset after each spike
+    const double expected[3] = {0.2928413750231185, 0.7123582777578916, 1.4712357718217604};
+    ASSERT_EQ(monitor->spike_list.size(), 3);
+    for (size_t k = 0; k < 3; ++k)
+        EXPECT_NEAR(monitor->spike_list[k].first, expected[k], 1e-9);
+    double t = monitor->spike_list[0].first;
+    double A = 2.0 * tau_m * tau_syn / (C_m * (tau_syn - tau_m));
+    EXPECT_NEAR(-A * std::exp(-t / tau_m) + A * std::exp(-t / tau_syn), v_thresh, 1e-9);
+}
+
+// tau_m == tau_syn: u(s) = (u0 + I0 s / C_m) e^(-s/tau_m)
+TEST_F(MultiStateNeuronTest, ExpCurrentLIFPredictedCrossingEqualTaus) {
+    NeuralNetwork net;
+    net.add_neuron_population(1, std::make_shared<ExpCurrentLIFNeuron>(1.0, 1.0, 1.0, 0.0, 0.0, 0.5, 0.0));
+    auto monitor = std::make_shared<SpikeMonitor>();
+    net.set_spike_monitor(monitor);
+    net.schedule_spike_event(0.0, 0, 2.0);
+    net.run(5.0);
+
+    const double expected[2] = {0.3574029561813889, 1.135884971729272};
+    ASSERT_EQ(monitor->spike_list.size(), 2);
+    for (size_t k = 0; k < 2; ++k)
+        EXPECT_NEAR(monitor->spike_list[k].first, expected[k], 1e-9);
+    double t = monitor->spike_list[0].first;
+    EXPECT_NEAR(2.0 * t * std::exp(-t), 0.5, 1e-9);
+}
+
+// Time of the first peak crossing of a neuron left alone from its current state, one integration step at a time
+static double crossing_time(MultiStateNeuron& neuron, double* const* vars, double* last_spike, double* last_update,
+                            double dt_int, double peak) {
+    for (size_t k = 1; k < 100000; ++k) {
+        neuron.decay_vars(k * dt_int, vars, last_spike, last_update, 1);
+        if (vars[0][0] >= peak) return k * dt_int;
+    }
+    return std::numeric_limits<double>::infinity();
+}
+
+// Past the soft threshold the runaway needs no further input: the spike is emitted at the crossing,
+// and an inhibitory input arriving afterwards does not cancel it
+TEST_F(MultiStateNeuronTest, AdExRunawayWithoutInput) {
+    auto model = std::make_shared<AdExNeuron>();
+    const double charge = model->C_m_ * (-45e-3 - model->E_L_);
+    v[0] = model->E_L_ + charge / model->C_m_;
+    x[0] = 0.0;
+    const double expected = crossing_time(*model, vars, last_spike, last_update, model->dt_int_, model->v_peak_);
+    ASSERT_LT(expected, 0.05);
+
+    // Held at the peak, the neuron fires on the next input even if it is inhibitory
+    EXPECT_TRUE(model->receive_vars(expected, -charge, vars, last_spike, last_update));
+    EXPECT_DOUBLE_EQ(v[0], model->v_reset_);
+
+    for (bool inhibition : {false, true}) {
+        NeuralNetwork net;
+        net.add_neuron_population(1, model);
+        net.schedule_spike_event(0.0, 0, charge);
+        if (inhibition) net.schedule_spike_event(0.05, 0, -charge);
+        auto monitor = std::make_shared<SpikeMonitor>();
+        net.set_spike_monitor(monitor);
+        net.run(0.1);
+        ASSERT_EQ(monitor->spike_list.size(), 1);
+        EXPECT_NEAR(monitor->spike_list[0].first, expected, 1e-12);
+    }
+}
+
+// Izhikevich neuron pushed past its unstable fixed point spikes on its own
+TEST_F(MultiStateNeuronTest, IzhikevichSpikeWithoutInput) {
+    auto model = std::make_shared<IzhikevichNeuron>();
+    v[0] = model->c_ + 20.0;
+    x[0] = model->b_ * model->c_;
+    const double expected = crossing_time(*model, vars, last_spike, last_update, model->dt_int_, IzhikevichNeuron::V_PEAK);
+    ASSERT_LT(expected, 0.05);
+
+    for (bool inhibition : {false, true}) {
+        NeuralNetwork net;
+        net.add_neuron_population(1, model);
+        net.schedule_spike_event(0.0, 0, 20.0);
+        if (inhibition) net.schedule_spike_event(0.05, 0, -20.0);
+        auto monitor = std::make_shared<SpikeMonitor>();
+        net.set_spike_monitor(monitor);
+        net.run(0.1);
+        ASSERT_EQ(monitor->spike_list.size(), 1);
+        EXPECT_NEAR(monitor->spike_list[0].first, expected, 1e-12);
+    }
+}
+
+// Threshold below rest: the relaxation from reset towards rest crosses it without any input
+TEST_F(MultiStateNeuronTest, ExpCurrentLIFRelaxationCrossing) {
+    NeuralNetwork net;
+    net.add_neuron_population(1, std::make_shared<ExpCurrentLIFNeuron>(10.0, 1.0, 1.0, 0.0, -1.0, -0.5, 0.0));
+    auto monitor = std::make_shared<SpikeMonitor>();
+    net.set_spike_monitor(monitor);
+    net.run(15.0);
+    ASSERT_EQ(monitor->spike_list.size(), 2);
+    for (size_t k = 0; k < 2; ++k)
+        EXPECT_NEAR(monitor->spike_list[k].first, (k + 1) * 10.0 * std::log(2.0), 1e-9);
+
+    // An inhibitory current delays the crossing past the minimum of the trajectory
+    for (double tau_syn : {1.0, 10.0}) {
+        ExpCurrentLIFNeuron neuron(10.0, tau_syn, 1.0, 0.0, -1.0, -0.5, 0.0);
+        v[0] = -1.0;
+        x[0] = -0.5;
+        last_update[0] = 0.0;
+        const double predicted = neuron.next_spike_time(vars, last_spike, last_update);
+        const double expected = crossing_time(neuron, vars, last_spike, last_update, 1e-3, -0.5);
+        EXPECT_GT(predicted, 10.0 * std::log(2.0));
+        EXPECT_NEAR(predicted, expected, 1e-3);
+    }
+}
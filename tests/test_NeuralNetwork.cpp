@@ -3,6 +3,9 @@
 #include "LIFNeuron.h"
 #include <memory>
 #include <vector>
+#include <cmath>
+#include <algorithm>
+#include <type_traits>
 
 class NeuralNetworkTest : public ::testing::Test {
 protected:
@@ -154,3 +157,312 @@ TEST_F(NeuralNetworkTest, TimeContinuity) {
 }
 
 
+// Per-neuron parameters within a single population
+TEST_F(NeuralNetworkTest, HeterogeneousPopulation) {
+    NeuralNetwork net;
+    auto neuron_type = std::make_shared<LIFNeuron>(tau_m, C_m, v_rest, v_reset, v_thresh, refractory);
+    net.add_neuron_population(3, neuron_type);
+
+    // Homogeneous until a parameter array is set
+    EXPECT_EQ(net.get_population_param(0, "tau_m"), std::vector<double>(3, tau_m));
+    net.set_population_param(0, "v_thresh", {1.0, 2.0, 3.0});
+    net.set_population_param(0, "tau_m", {1.0, 10.0, 100.0});
+    EXPECT_EQ(net.get_population_param(0, "refractory"), std::vector<double>(3, refractory));
+    EXPECT_THROW(net.set_population_param(0, "tau_m", {1.0}), std::invalid_argument);
+    EXPECT_THROW(net.set_population_param(0, "unknown", {1.0, 1.0, 1.0}), std::invalid_argument);
+
+    auto monitor = std::make_shared<SpikeMonitor>();
+    net.set_spike_monitor(monitor);
+    for (size_t i = 0; i < 3; ++i)
+        net.schedule_spike_event(0.0, i, 2.5);
+    net.run(1.0);
+
+    // Only neurons 0 and 1 reach their thresholds
+    ASSERT_EQ(monitor->spike_list.size(), 2);
+    EXPECT_EQ(monitor->spike_list[0].second + monitor->spike_list[1].second, 1);
+
+    // Decay uses each neuron's own time constant
+    auto state = std::make_shared<StateMonitor>(1.0);
+    net.set_state_monitor(state);
+    net.schedule_spike_event(0.0, 2, 0.1);
+    net.run(1.0);
+    auto v = net.get_population_state(0, 0);
+    EXPECT_NEAR(v[2], (2.5 * std::exp(-1.0 / 100.0) + 0.1) * std::exp(-1.0 / 100.0), 1e-9);
+}
+
+// Neurons driven by a bias current fire on their own at the predicted times
+TEST_F(NeuralNetworkTest, PredictedSelfSpikes) {
+    NeuralNetwork net;
+    // v_inf = 2.0, crossing after tau_m * ln(2) from reset
+    auto neuron_type = std::make_shared<LIFNeuron>(tau_m, C_m, v_rest, v_reset, v_thresh, refractory, 0.2);
+    net.add_neuron_population(1, neuron_type);
+    net.add_neuron_population(1, std::make_shared<LIFNeuron>(tau_m, C_m, v_rest, v_reset, v_thresh, refractory));
+    net.add_synapse(Synapse{0, 1, 0.8, 1.0});
+
+    auto monitor = std::make_shared<SpikeMonitor>();
+    net.set_spike_monitor(monitor);
+    net.run(20.0);
+
+    double period = tau_m * std::log(2.0);
+    ASSERT_EQ(monitor->spike_list.size(), 3);
+    EXPECT_NEAR(monitor->spike_list[0].first, period, 1e-9);
+    EXPECT_EQ(monitor->spike_list[0].second, 0);
+    EXPECT_NEAR(monitor->spike_list[1].first, 2 * period, 1e-9);
+    // Two inputs of 0.8 make neuron 1 fire
+    EXPECT_EQ(monitor->spike_list[2].second, 1);
+    EXPECT_NEAR(monitor->spike_list[2].first, 2 * period + 1.0, 1e-9);
+
+    // An input at t = 20 takes neuron 0 over threshold - the crossing queued for 3 * period is dropped
+    // and the next one is predicted from the reset
+    net.reset_monitors();
+    net.schedule_spike_event(0.0, 0, 0.1);
+    net.run(10.0);
+    ASSERT_EQ(monitor->spike_list.size(), 3);
+    EXPECT_EQ(monitor->spike_list[0], std::make_pair(20.0, size_t(0)));
+    EXPECT_NEAR(monitor->spike_list[1].first, 20.0 + period, 1e-9);
+    EXPECT_EQ(monitor->spike_list[1].second, 0);
+    EXPECT_NEAR(monitor->spike_list[2].first, 21.0 + period, 1e-9);
+    EXPECT_EQ(monitor->spike_list[2].second, 1);
+
+    // Removing the bias stops self-spiking - the crossing queued for 20 + 2 * period is dropped
+    net.reset_monitors();
+    neuron_type->i_bias_ = 0.0;
+    net.run(20.0);
+    EXPECT_TRUE(monitor->spike_list.empty());
+}
+
+TEST_F(NeuralNetworkTest, BulkWeightsAndDelays) {
+    NeuralNetwork net;
+    net.add_neuron_population(2, std::make_shared<LIFNeuron>());
+    net.add_neuron_population(2, std::make_shared<LIFNeuron>());
+    net.add_synapse(Synapse{0, 2, 0.1, 1.0});
+    net.add_synapse(Synapse{0, 1, 0.2, 1.0});
+    net.add_synapse(Synapse{1, 3, 0.3, 2.0});
+    ASSERT_EQ(net.num_synapses(), 3);
+
+    // Same order as get_synapses, writes go straight to the storage
+    std::vector<double>& weights = net.get_weights();
+    EXPECT_EQ(weights, (std::vector<double>{0.1, 0.2, 0.3}));
+    weights[2] = 0.5;
+    EXPECT_DOUBLE_EQ(net.get_synapses()[2].weight, 0.5);
+
+    net.set_delays({0.5, 0.25, 0.125});
+    EXPECT_DOUBLE_EQ(net.get_synapses()[1].delay, 0.25);
+    EXPECT_THROW(net.set_weights({1.0}), std::invalid_argument);
+    EXPECT_THROW(net.set_delays({1.0, -1.0, 0.0}), std::invalid_argument);
+
+    // Only population 0 -> population 1 synapses are scaled
+    net.scale_weights(0, 1, 2.0);
+    EXPECT_EQ(net.get_weights(), (std::vector<double>{0.2, 0.2, 1.0}));
+    EXPECT_THROW(net.scale_weights(0, 2, 2.0), std::out_of_range);
+}
+
+// Fan-out is delivered through one packet per delay group - every target still fires at t + delay
+TEST_F(NeuralNetworkTest, SpikePackets) {
+    NeuralNetwork net;
+    net.add_neuron_population(7, std::make_shared<LIFNeuron>(tau_m, C_m, v_rest, v_reset, v_thresh, refractory));
+    const double delays[6] = {3.0, 1.0, 2.0, 1.0, 3.0, 2.0};
+    for (size_t j = 0; j < 6; ++j) net.add_synapse(Synapse(0, j + 1, 2.0, delays[j]));
+
+    auto monitor = std::make_shared<SpikeMonitor>();
+    net.set_spike_monitor(monitor);
+    net.schedule_spike_event(1.0, 0, 2.0);
+    net.run(10.0);
+
+    ASSERT_EQ(monitor->spike_list.size(), 7);
+    for (const auto& [t, id] : monitor->spike_list)
+        EXPECT_DOUBLE_EQ(t, id == 0 ? 1.0 : 1.0 + delays[id - 1]);
+
+    // The bulk view is read-only; delays changed through set_delays regroup the synapses on every later run,
+    // and a view retained across runs follows them
+    static_assert(std::is_const_v<std::remove_reference_t<decltype(net.get_delays())>>);
+    auto synapses = net.get_synapses();
+    const std::vector<double>& d = net.get_delays();
+    for (double late : {4.0, 2.0}) {
+        std::vector<double> updated(d.size());
+        for (size_t s = 0; s < d.size(); ++s) updated[s] = synapses[s].dst_id == 1 ? 0.5 : late;
+        net.set_delays(updated);
+        EXPECT_EQ(d, updated);
+        net.reset_monitors();
+        const double t0 = net.sim_time;
+        net.schedule_spike_event(1.0, 0, 2.0);
+        net.run(10.0);
+
+        ASSERT_EQ(monitor->spike_list.size(), 7);
+        for (const auto& [t, id] : monitor->spike_list)
+            EXPECT_DOUBLE_EQ(t, id == 0 ? t0 + 1.0 : t0 + 1.0 + (id == 1 ? 0.5 : late));
+    }
+    std::vector<double> negative(d.size(), 1.0);
+    negative[0] = -1.0;
+    EXPECT_THROW(net.set_delays(negative), std::invalid_argument);
+}
+
+// Packets queued across runs keep their targets when the delay groups are rebuilt
+TEST_F(NeuralNetworkTest, InFlightPacketsSurviveRegrouping) {
+    NeuralNetwork net;
+    net.add_neuron_population(6, std::make_shared<LIFNeuron>(tau_m, C_m, v_rest, v_reset, v_thresh, refractory));
+    net.add_synapse(Synapse(1, 4, 2.0, 5.0));
+
+    auto monitor = std::make_shared<SpikeMonitor>();
+    net.set_spike_monitor(monitor);
+    net.schedule_spike_event(1.0, 1, 2.0);
+    net.run(3.0);
+    ASSERT_EQ(monitor->spike_list.size(), 1);
+
+    // Added to an earlier row while the packet of 1 -> 4 is still queued
+    net.add_synapse(Synapse(0, 5, 2.0, 1.0));
+    net.run(10.0);
+    ASSERT_EQ(monitor->spike_list.size(), 2);
+    EXPECT_EQ(monitor->spike_list[1], std::make_pair(6.0, size_t(4)));
+}
+
+// FIFO delay lanes give the same spikes as the priority queue, also across synapse changes with packets queued
+TEST_F(NeuralNetworkTest, DelayLanesMatchPriorityQueue) {
+    auto simulate = [&](size_t max_lanes) {
+        NeuralNetwork net;
+        net.set_max_delay_lanes(max_lanes);
+        net.add_neuron_population(60, std::make_shared<LIFNeuron>(tau_m, C_m, v_rest, v_reset, v_thresh, refractory));
+        net.connect_random(0, 0, 0.2, Distribution::uniform(0.2, 0.6), Distribution(1.0), 1, false);
+        net.connect_random(0, 0, 0.05, Distribution::uniform(0.2, 0.6), Distribution(2.5), 2, false);
+        for (size_t i = 0; i < 60; ++i) net.schedule_spike_event(0.1 * i, i, 1.5);
+
+        auto monitor = std::make_shared<SpikeMonitor>();
+        net.set_spike_monitor(monitor);
+        net.run(5.3);
+        // Regrouped while packets of the first run are still queued
+        net.add_synapse(Synapse(0, 1, 0.5, 0.5));
+        net.run(20.0);
+        // Events at equal times may be processed in a different order
+        auto spikes = monitor->spike_list;
+        std::sort(spikes.begin(), spikes.end());
+        return spikes;
+    };
+
+    auto with_lanes = simulate(16);
+    EXPECT_GT(with_lanes.size(), 60);
+    EXPECT_EQ(with_lanes, simulate(0));
+    EXPECT_EQ(with_lanes, simulate(1));
+}
+
+// float32 weight storage - same results when the weights are exactly representable
+TEST_F(NeuralNetworkTest, SinglePrecisionWeights) {
+    auto simulate = [&](auto& net) {
+        net.add_neuron_population(50, std::make_shared<LIFNeuron>(tau_m, C_m, v_rest, v_reset, v_thresh, refractory));
+        net.connect_random(0, 0, 0.2, Distribution(0.375), Distribution(1.0), 4, false);
+        net.add_stdp_rule(std::make_shared<STDPRule>(0, 50, 0, 50));
+        for (size_t i = 0; i < 50; ++i) net.schedule_spike_event(0.2 * i, i, 1.5);
+        auto monitor = std::make_shared<SpikeMonitor>();
+        net.set_spike_monitor(monitor);
+        net.run(20.0);
+        auto spikes = monitor->spike_list;
+        std::sort(spikes.begin(), spikes.end());
+        return spikes;
+    };
+
+    NeuralNetwork net64;
+    NeuralNetworkF32 net32;
+    auto spikes64 = simulate(net64);
+    auto spikes32 = simulate(net32);
+    EXPECT_EQ(spikes64, spikes32);
+
+    static_assert(std::is_same_v<std::remove_reference_t<decltype(net32.get_weights())>, std::vector<float>>);
+    static_assert(std::is_same_v<SynapseIndex<float>, uint32_t> && std::is_same_v<SynapseIndex<double>, size_t>);
+    ASSERT_EQ(net32.num_synapses(), net64.num_synapses());
+    for (size_t s = 0; s < net32.num_synapses(); ++s)
+        EXPECT_NEAR(net32.get_weights()[s], net64.get_weights()[s], 1e-6);
+}
+
+// Chunked runs resume where the previous one stopped - same spikes and readings as one run, no duplicated boundary reading
+TEST_F(NeuralNetworkTest, ChunkedRuns) {
+    auto build = [&](NeuralNetwork& net, std::shared_ptr<SpikeMonitor> spikes, std::shared_ptr<StateMonitor> states) {
+        net.add_neuron_population(40, std::make_shared<LIFNeuron>(tau_m, C_m, v_rest, v_reset, v_thresh, refractory));
+        net.connect_random(0, 0, 0.2, Distribution::uniform(0.2, 0.6), Distribution::uniform(0.3, 1.7), 3, false);
+        net.set_spike_monitor(spikes);
+        net.set_state_monitor(states);
+    };
+    auto sorted = [](std::vector<std::pair<double, size_t>> spikes) {
+        std::sort(spikes.begin(), spikes.end());
+        return spikes;
+    };
+
+    NeuralNetwork whole;
+    auto whole_spikes = std::make_shared<SpikeMonitor>();
+    auto whole_states = std::make_shared<StateMonitor>(0.5);
+    build(whole, whole_spikes, whole_states);
+    // Off the reading times - events at equal times may be processed in either order
+    for (size_t i = 0; i < 40; ++i) whole.schedule_spike_event(0.25 * i + 0.1, i, 1.5);
+    whole.run(10.0);
+
+    NeuralNetwork chunked;
+    auto chunked_spikes = std::make_shared<SpikeMonitor>();
+    auto chunked_states = std::make_shared<StateMonitor>(0.5);
+    build(chunked, chunked_spikes, chunked_states);
+    EXPECT_THROW(chunked.step(), std::logic_error);
+    chunked.set_step(0.25);
+    // Inputs injected between steps, shortly before they are due
+    for (size_t k = 0; k < 40; ++k) {
+        chunked.schedule_spike_events({0.1}, {k}, {1.5});
+        chunked.step();
+    }
+    EXPECT_EQ(chunked.sim_time, 10.0);
+    EXPECT_THROW(chunked.run_until(5.0), std::invalid_argument);
+    EXPECT_THROW(chunked.schedule_spike_events({0.0, 1.0}, {0}, {1.0}), std::invalid_argument);
+
+    EXPECT_GT(whole_spikes->spike_list.size(), 40);
+    EXPECT_EQ(sorted(chunked_spikes->spike_list), sorted(whole_spikes->spike_list));
+    ASSERT_EQ(whole_states->state_vector_list.size(), 21);
+    ASSERT_EQ(chunked_states->state_vector_list.size(), 21);
+    for (size_t r = 0; r < 21; ++r) {
+        EXPECT_EQ(chunked_states->state_vector_list[r].first, 0.5 * r);
+        EXPECT_EQ(chunked_states->state_vector_list[r].second, whole_states->state_vector_list[r].second);
+    }
+
+    // A new monitor starts its own schedule at the next run - the reading queued for the old one is dropped
+    auto late_states = std::make_shared<StateMonitor>(1.0);
+    chunked.set_state_monitor(late_states);
+    chunked.run_until(10.75);
+    chunked.run_until(12.0);
+    ASSERT_EQ(late_states->state_vector_list.size(), 3);
+    EXPECT_EQ(late_states->state_vector_list[0].first, 10.0);
+    EXPECT_EQ(late_states->state_vector_list[2].first, 12.0);
+    EXPECT_EQ(chunked_states->state_vector_list.size(), 21);
+}
+
+// A reset network repeats the run of a freshly built one - also when reset in the middle of a run
+TEST_F(NeuralNetworkTest, ResetRepeatsFreshRun) {
+    auto simulate = [&](NeuralNetwork& net, std::shared_ptr<SpikeMonitor> spikes, std::shared_ptr<StateMonitor> states) {
+        for (size_t k = 0; k < 20; ++k) net.schedule_spike_event(0.3 * k + 0.1, k, 1.5);
+        net.run(10.0);
+        auto list = spikes->spike_list;
+        std::sort(list.begin(), list.end());
+        return std::make_pair(list, states->state_vector_list);
+    };
+
+    NeuralNetwork net;
+    auto generator = std::make_shared<SpikeGenerator>(10, SpikeGenerator::Mode::Poisson, 5);
+    generator->set_rates(std::vector<double>(10, 2.0));
+    net.add_input_population(generator);
+    net.add_neuron_population(40, std::make_shared<LIFNeuron>(tau_m, C_m, v_rest, v_reset, v_thresh, refractory));
+    net.connect_random(0, 1, 0.3, Distribution(0.6), Distribution::uniform(0.5, 1.5), 1);
+    net.connect_random(1, 1, 0.2, Distribution::uniform(0.2, 0.6), Distribution::uniform(0.3, 1.7), 3, false);
+    auto spikes = std::make_shared<SpikeMonitor>();
+    auto states = std::make_shared<StateMonitor>(0.5);
+    net.set_spike_monitor(spikes);
+    net.set_state_monitor(states);
+
+    auto fresh = simulate(net, spikes, states);
+    EXPECT_GT(fresh.first.size(), 40);
+    ASSERT_EQ(fresh.second.size(), 21);
+
+    net.reset();
+    EXPECT_EQ(net.sim_time, 0.0);
+    EXPECT_TRUE(spikes->spike_list.empty());
+    EXPECT_EQ(simulate(net, spikes, states), fresh);
+
+    // Queued events, pending readings and the neuron state of an interrupted run are discarded
+    net.reset();
+    for (size_t k = 0; k < 20; ++k) net.schedule_spike_event(0.2 * k, 20 + k, 2.0);
+    net.run(3.05);
+    net.reset();
+    EXPECT_EQ(simulate(net, spikes, states), fresh);
+}
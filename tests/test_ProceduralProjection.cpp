@@ -0,0 +1,101 @@
+#include "ProceduralProjection.h"
+#include "NeuralNetwork.h"
+#include "InputNeuron.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <set>
+
+using Connectivity = ProceduralProjection::Connectivity;
+
+// The same source always regenerates the same synapses
+TEST(ProceduralProjectionTest, Deterministic) {
+    ProceduralProjection proj(0, 10, 10, 1000, Connectivity::FixedProbability, 0.1, 0.2, 0.4, 0.001, 0.003, 42);
+    std::vector<Synapse> a, b, c;
+    proj.generate(3, a);
+    proj.generate(3, b);
+    proj.generate(4, c);
+
+    ASSERT_EQ(a.size(), b.size());
+    for (size_t i = 0; i < a.size(); ++i) {
+        EXPECT_EQ(a[i].dst_id, b[i].dst_id);
+        EXPECT_EQ(a[i].weight, b[i].weight);
+        EXPECT_EQ(a[i].delay, b[i].delay);
+    }
+    ASSERT_FALSE(c.empty());
+    EXPECT_FALSE(a[0].dst_id == c[0].dst_id && a[0].weight == c[0].weight);
+}
+
+TEST(ProceduralProjectionTest, FixedProbabilityStatistics) {
+    ProceduralProjection proj(0, 100, 100, 1000, Connectivity::FixedProbability, 0.05, 0.2, 0.4, 0.001, 0.003, 7);
+    std::vector<Synapse> out;
+    for (size_t i = 0; i < 100; ++i) proj.generate(i, out);
+
+    EXPECT_NEAR(out.size() / 100.0, 50.0, 3.0);
+    for (const auto& syn : out) {
+        EXPECT_GE(syn.dst_id, 100);
+        EXPECT_LT(syn.dst_id, 1100);
+        EXPECT_GE(syn.weight, 0.2);
+        EXPECT_LE(syn.weight, 0.4);
+        EXPECT_GE(syn.delay, 0.001);
+        EXPECT_LE(syn.delay, 0.003);
+    }
+}
+
+TEST(ProceduralProjectionTest, FixedOutDegreeAndAutapses) {
+    // Every eligible target: all but the source itself
+    ProceduralProjection full(0, 4, 0, 4, Connectivity::FixedOutDegree, 3, 1.0, 1.0, 0.0, 0.0, 1, false);
+    std::vector<Synapse> out;
+    full.generate(2, out);
+    ASSERT_EQ(out.size(), 3);
+    EXPECT_EQ(out[0].dst_id, 0);
+    EXPECT_EQ(out[1].dst_id, 1);
+    EXPECT_EQ(out[2].dst_id, 3);
+
+    ProceduralProjection proj(0, 100, 50, 100, Connectivity::FixedOutDegree, 20, 0.5, 1.0, 0.001, 0.002, 7, false);
+    for (size_t i = 0; i < 100; ++i) {
+        out.clear();
+        proj.generate(i, out);
+        ASSERT_EQ(out.size(), 20);
+        std::set<size_t> targets;
+        for (const auto& syn : out) {
+            EXPECT_NE(syn.dst_id, i);
+            EXPECT_GE(syn.dst_id, 50);
+            EXPECT_LT(syn.dst_id, 150);
+            targets.insert(syn.dst_id);
+        }
+        EXPECT_EQ(targets.size(), 20);
+    }
+
+    EXPECT_THROW(ProceduralProjection(0, 4, 0, 4, Connectivity::FixedOutDegree, 4, 1.0, 1.0, 0.0, 0.0, 1, false), std::invalid_argument);
+    EXPECT_THROW(ProceduralProjection(0, 4, 4, 4, Connectivity::FixedOutDegree, 5, 1.0, 1.0, 0.0, 0.0), std::invalid_argument);
+    EXPECT_NO_THROW(ProceduralProjection(0, 4, 4, 4, Connectivity::FixedOutDegree, 4, 1.0, 1.0, 0.0, 0.0, 1, false));
+    EXPECT_THROW(ProceduralProjection(0, 1, 0, 1, Connectivity::FixedProbability, 1.5, 1.0, 1.0, 0.0, 0.0), std::invalid_argument);
+    EXPECT_THROW(ProceduralProjection(0, 4, 4, 4, Connectivity::FixedOutDegree, 2.5, 1.0, 1.0, 0.0, 0.0), std::invalid_argument);
+    EXPECT_THROW(ProceduralProjection(0, 4, 4, 4, Connectivity::FixedOutDegree, 2, 1.0, 1.0, -0.001, 0.0), std::invalid_argument);
+    EXPECT_THROW(ProceduralProjection(0, 4, 4, 4, Connectivity::FixedOutDegree, 2, 1.0, 1.0, 0.002, 0.001), std::invalid_argument);
+    EXPECT_THROW(ProceduralProjection(0, 4, 4, 4, Connectivity::FixedOutDegree, 2, 1.0, 0.5, 0.0, 0.0), std::invalid_argument);
+}
+
+// Spikes reach the generated targets without any stored synapse
+TEST(ProceduralProjectionTest, NetworkFanOut) {
+    NeuralNetwork net;
+    net.add_neuron_population(51, std::make_shared<InputNeuron>());
+    auto proj = std::make_shared<ProceduralProjection>(0, 1, 1, 50, Connectivity::FixedOutDegree, 5, 1.0, 1.0, 0.001, 0.002, 3);
+    net.add_projection(proj);
+    EXPECT_THROW(net.add_projection(std::make_shared<ProceduralProjection>(0, 1, 1, 60, Connectivity::FixedOutDegree, 5, 1.0, 1.0, 0.0, 0.0)),
+                 std::out_of_range);
+
+    auto monitor = std::make_shared<SpikeMonitor>();
+    net.set_spike_monitor(monitor);
+    net.schedule_spike_event(0.0, 0, 1.0);
+    net.run(0.01);
+
+    EXPECT_TRUE(net.get_synapses().empty());
+    std::vector<Synapse> expected;
+    proj->generate(0, expected);
+    ASSERT_EQ(monitor->spike_list.size(), 1 + expected.size());
+    for (size_t i = 1; i < monitor->spike_list.size(); ++i) {
+        EXPECT_GE(monitor->spike_list[i].first, 0.001);
+        EXPECT_GE(monitor->spike_list[i].second, 1);
+    }
+}
@@ -0,0 +1,69 @@
+#include "STDPRule.h"
+#include "NeuralNetwork.h"
+#include "InputNeuron.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <memory>
+
+class STDPRuleTest : public ::testing::Test {
+protected:
+    // 0 -> 2, 1 -> 2
+    void SetUp() override {
+        std::vector<std::vector<Synapse>> staged(3);
+        staged[0].emplace_back(0, 2, 0.5, 0.0);
+        staged[1].emplace_back(1, 2, 0.5, 0.0);
+        synapses.append(staged);
+        synapses.build_reverse_index();
+    }
+
+    SynapseMatrix synapses;
+    double tau = 0.02;
+};
+
+TEST_F(STDPRuleTest, ReverseIndex) {
+    ASSERT_EQ(synapses.in_ptr[3] - synapses.in_ptr[2], 2);
+    EXPECT_EQ(synapses.src[synapses.in_syn[synapses.in_ptr[2]]], 0);
+    EXPECT_EQ(synapses.src[synapses.in_syn[synapses.in_ptr[2] + 1]], 1);
+}
+
+// Pre before post potentiates, post before pre depresses
+TEST_F(STDPRuleTest, PairRule) {
+    STDPRule rule(0, 2, 2, 1, tau, tau, 0.1, 0.1, 0.0, 1.0);
+    rule.on_pre_spike(0.0, 0, synapses);
+    rule.on_post_spike(0.01, 2, synapses);
+    EXPECT_NEAR(synapses.weight[0], 0.5 + 0.1 * std::exp(-0.01 / tau), 1e-12);
+
+    rule.on_pre_spike(0.03, 1, synapses);
+    EXPECT_NEAR(synapses.weight[1], 0.5 - 0.1 * std::exp(-0.02 / tau), 1e-12);
+}
+
+TEST_F(STDPRuleTest, TripletAndBounds) {
+    STDPRule rule(0, 2, 2, 1, tau, tau, 0.4, 0.0, 0.0, 1.0);
+    rule.set_triplet(tau, tau, 0.4, 0.0);
+
+    rule.on_pre_spike(0.0, 0, synapses);
+    rule.on_post_spike(0.0, 2, synapses);   // o2 = 0 before the first post spike
+    EXPECT_NEAR(synapses.weight[0], 0.9, 1e-12);
+    rule.on_post_spike(0.0, 2, synapses);   // now o2 = 1, clipped at w_max
+    EXPECT_DOUBLE_EQ(synapses.weight[0], 1.0);
+}
+
+// Weights change during run() and are visible through get_synapses
+TEST_F(STDPRuleTest, PlasticNetwork) {
+    NeuralNetwork net;
+    net.add_neuron_population(2, std::make_shared<InputNeuron>());
+    net.add_synapse(Synapse{0, 1, 0.5, 0.001});
+    net.add_stdp_rule(std::make_shared<STDPRule>(0, 1, 1, 1, tau, tau, 0.1, 0.1, 0.0, 1.0));
+    EXPECT_THROW(net.add_stdp_rule(std::make_shared<STDPRule>(0, 1, 1, 5)), std::out_of_range);
+
+    // Input neuron 1 fires 5 ms after neuron 0, repeatedly
+    for (int k = 0; k < 3; ++k) {
+        net.schedule_spike_event(0.1 * k, 0, 1.0);
+        net.schedule_spike_event(0.1 * k + 0.005, 1, 1.0);
+    }
+    net.run(1.0);
+
+    auto synapses = net.get_synapses();
+    ASSERT_EQ(synapses.size(), 1);
+    EXPECT_GT(synapses[0].weight, 0.5);
+}
@@ -0,0 +1,68 @@
+#include "SpikeCountMonitor.h"
+#include "NeuralNetwork.h"
+#include "InputNeuron.h"
+#include <gtest/gtest.h>
+#include <memory>
+
+TEST(SpikeCountMonitorTest, CountsPerNeuron) {
+    SpikeCountMonitor monitor;
+    monitor.resize(3);
+    monitor.on_run_start(0.0);
+    monitor.on_spike(0.1, 0);
+    monitor.on_spike(0.2, 2);
+    monitor.on_spike(0.3, 2);
+    monitor.on_run_end(2.0);
+
+    EXPECT_EQ(monitor.counts[0], 1);
+    EXPECT_EQ(monitor.counts[1], 0);
+    EXPECT_EQ(monitor.counts[2], 2);
+
+    auto rates = monitor.get_rates();
+    EXPECT_DOUBLE_EQ(rates[0], 0.5);
+    EXPECT_DOUBLE_EQ(rates[2], 1.0);
+}
+
+TEST(SpikeCountMonitorTest, WindowedRates) {
+    SpikeCountMonitor monitor(1.0);
+    monitor.resize(2);
+    monitor.on_run_start(0.0);
+    monitor.on_spike(0.5, 0);
+    monitor.on_spike(0.7, 0);
+    monitor.on_spike(1.5, 1);   // closes window [0, 1)
+
+    auto rates = monitor.get_window_rates();
+    EXPECT_DOUBLE_EQ(rates[0], 2.0);
+    EXPECT_DOUBLE_EQ(rates[1], 0.0);
+    EXPECT_EQ(monitor.window_counts[1], 1);
+
+    // Window [2, 3) has no spikes
+    monitor.on_spike(3.2, 0);
+    rates = monitor.get_window_rates();
+    EXPECT_DOUBLE_EQ(rates[0], 0.0);
+    EXPECT_DOUBLE_EQ(rates[1], 0.0);
+
+    // Run end closes the current window
+    monitor.on_run_end(4.0);
+    EXPECT_EQ(monitor.last_window_counts[0], 1);
+    EXPECT_EQ(monitor.counts[0], 3);
+}
+
+TEST(SpikeCountMonitorTest, AttachedToNetwork) {
+    NeuralNetwork net;
+    net.add_neuron_population(3, std::make_shared<InputNeuron>());
+    auto monitor = std::make_shared<SpikeCountMonitor>();
+    net.set_spike_count_monitor(monitor);
+
+    net.schedule_spike_event(0.1, 1, 1.0);
+    net.schedule_spike_event(0.2, 1, 1.0);
+    net.schedule_spike_event(0.3, 2, 1.0);
+    net.run(1.0);
+
+    ASSERT_EQ(monitor->counts.size(), 3);
+    EXPECT_EQ(monitor->counts[0], 0);
+    EXPECT_EQ(monitor->counts[1], 2);
+    EXPECT_EQ(monitor->counts[2], 1);
+
+    net.reset_monitors();
+    EXPECT_EQ(monitor->counts[1], 0);
+}
@@ -0,0 +1,102 @@
+#include "SpikeGenerator.h"
+#include "NeuralNetwork.h"
+#include "LIFNeuron.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <vector>
+
+// Same seed produces the same spike train
+TEST(SpikeGeneratorTest, DeterministicForSeed) {
+    SpikeGenerator gen_a(3, SpikeGenerator::Mode::Poisson, 42);
+    SpikeGenerator gen_b(3, SpikeGenerator::Mode::Poisson, 42);
+    gen_a.set_rates({10.0, 20.0, 30.0});
+    gen_b.set_rates({10.0, 20.0, 30.0});
+    gen_a.arm(0.0);
+    gen_b.arm(0.0);
+
+    double t_a = 0.0, t_b = 0.0;
+    for (int i = 0; i < 100; ++i) {
+        t_a = gen_a.next_spike_time(1, t_a);
+        t_b = gen_b.next_spike_time(1, t_b);
+        EXPECT_EQ(t_a, t_b);
+    }
+}
+
+// Poisson spike count approaches rate * duration
+TEST(SpikeGeneratorTest, PoissonRate) {
+    SpikeGenerator gen(1, SpikeGenerator::Mode::Poisson, 7);
+    gen.set_rates({100.0});
+    gen.arm(0.0);
+
+    size_t count = 0;
+    for (double t = gen.next_spike_time(0, 0.0); t < 100.0; t = gen.next_spike_time(0, t))
+        ++count;
+    EXPECT_NEAR(count, 10000, 400);
+}
+
+// Regular spikes are evenly spaced
+TEST(SpikeGeneratorTest, RegularSpacing) {
+    SpikeGenerator gen(1, SpikeGenerator::Mode::Regular);
+    gen.set_rates({4.0});
+    gen.arm(1.0);
+
+    double t = gen.next_spike_time(0, 1.0);
+    EXPECT_DOUBLE_EQ(t, 1.25);
+    t = gen.next_spike_time(0, t);
+    EXPECT_DOUBLE_EQ(t, 1.5);
+}
+
+// Sources with zero rate never spike, inhomogeneous spikes only fall in active bins
+TEST(SpikeGeneratorTest, InhomogeneousProfile) {
+    SpikeGenerator gen(2, SpikeGenerator::Mode::Inhomogeneous, 3);
+    // Bin 0: source 0 silent, bin 1: source 0 active - source 1 always silent
+    gen.set_rate_profile({0.0, 0.0, 200.0, 0.0}, 1.0);
+    gen.arm(0.0);
+
+    double t = gen.next_spike_time(0, 0.0);
+    EXPECT_GE(t, 1.0);
+    EXPECT_LT(t, 2.0);
+    while (t != std::numeric_limits<double>::infinity()) {
+        EXPECT_LT(t, 2.0);
+        t = gen.next_spike_time(0, t);
+    }
+    EXPECT_EQ(gen.next_spike_time(1, 0.0), std::numeric_limits<double>::infinity());
+}
+
+TEST(SpikeGeneratorTest, InvalidRates) {
+    SpikeGenerator gen(2);
+    EXPECT_THROW(gen.set_rates({1.0}), std::invalid_argument);
+    EXPECT_THROW(gen.set_rates({1.0, -1.0}), std::invalid_argument);
+    EXPECT_THROW(gen.set_rate_profile({1.0, 1.0}, 1.0), std::invalid_argument);
+}
+
+// Input populations drive the network and keep spiking across runs
+TEST(SpikeGeneratorTest, InputPopulationInNetwork) {
+    NeuralNetwork net;
+    auto gen = std::make_shared<SpikeGenerator>(2, SpikeGenerator::Mode::Regular);
+    gen->set_rates({10.0, 0.0});
+    net.add_input_population(gen);
+    net.add_neuron_population(1, std::make_shared<LIFNeuron>(10.0, 1.0, 0.0, 0.0, 1.0, 0.0));
+    net.add_synapse(Synapse{0, 2, 1.5, 0.01});
+
+    auto monitor = std::make_shared<SpikeMonitor>();
+    net.set_spike_monitor(monitor);
+
+    net.run(1.0);
+    // Source 0 spikes at 0.1, ..., 1.0 and neuron 2 follows each spike
+    EXPECT_EQ(monitor->spike_list.size(), 19);
+    EXPECT_EQ(monitor->spike_list[0].second, 0);
+    EXPECT_NEAR(monitor->spike_list[0].first, 0.1, 1e-12);
+    EXPECT_EQ(monitor->spike_list[1].second, 2);
+
+    // Pending spike is kept for the next run
+    net.run(0.5);
+    EXPECT_EQ(monitor->spike_list.size(), 29);
+
+    // New rates take effect from the current simulation time
+    gen->set_rates({0.0, 0.0});
+    net.run(1.0);
+    EXPECT_EQ(monitor->spike_list.size(), 30);
+}
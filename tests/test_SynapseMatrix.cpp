@@ -0,0 +1,34 @@
+#include "gtest/gtest.h"
+#include "SynapseMatrix.h"
+#include <vector>
+
+// Rows are stable-sorted by delay, equal delays form one group
+TEST(SynapseMatrixTest, DelayGroups) {
+    std::vector<std::vector<Synapse>> staged(3);
+    staged[0] = {Synapse(0, 1, 0.1, 2.0), Synapse(0, 2, 0.2, 1.0), Synapse(0, 1, 0.3, 2.0), Synapse(0, 2, 0.4, 1.0)};
+    staged[2] = {Synapse(2, 0, 0.5, 0.5)};
+
+    SynapseMatrix m;
+    m.append(staged);
+    ASSERT_EQ(m.size(), 5);
+    EXPECT_EQ(m.weight, (std::vector<double>{0.2, 0.4, 0.1, 0.3, 0.5}));
+    EXPECT_EQ(m.delay, (std::vector<double>{1.0, 1.0, 2.0, 2.0, 0.5}));
+
+    // Row 1 has no synapses, hence no groups
+    EXPECT_EQ(m.row_group, (std::vector<size_t>{0, 2, 2, 3}));
+    EXPECT_EQ(m.group_ptr, (std::vector<size_t>{0, 2, 4, 5}));
+    EXPECT_EQ(m.num_groups(), 3);
+
+    // Synapses appended later are merged into the sorted rows
+    staged[0] = {Synapse(0, 0, 0.6, 1.5)};
+    m.append(staged);
+    EXPECT_EQ(m.weight, (std::vector<double>{0.2, 0.4, 0.6, 0.1, 0.3, 0.5}));
+    EXPECT_EQ(m.group_ptr, (std::vector<size_t>{0, 2, 3, 5, 6}));
+
+    // In-place delay changes split groups without reordering
+    m.delay[1] = 1.25;
+    m.build_delay_groups();
+    EXPECT_EQ(m.weight, (std::vector<double>{0.2, 0.4, 0.6, 0.1, 0.3, 0.5}));
+    EXPECT_EQ(m.row_group, (std::vector<size_t>{0, 4, 4, 5}));
+    EXPECT_EQ(m.group_ptr, (std::vector<size_t>{0, 1, 2, 3, 5, 6}));
+}